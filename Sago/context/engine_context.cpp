@@ -5,6 +5,7 @@
 #include <memory>
 
 #include "core/events/event_system.h"
+#include "core/memory/tracking/memory_tracker.h"
 #include "editor/editor_imgui_init.h"
 //Platform
 #include "editor/editor_imgui_init.h"
@@ -34,7 +35,7 @@ void EngineContext::ListenEventImpl() {
 	auto& dispatch_renderer = EventSystem::Instance().GetRendererDispatcher();
 
 	dispatch.subscribe<KeyEvent>([](const KeyEvent& e) {
-		LogInfoDetail("KeyDown{}", e.key_code_);
+		LogInfoLimit(Core::Log::LogCategory::kInput, 10, "KeyDown{}", e.key_code_);
 	});
 
 	dispatch.subscribe<WindowMinimizeEvent>([&](const WindowMinimizeEvent& e) {
@@ -84,11 +85,15 @@ void EngineContext::Tick() {
 	//EventProcess
 	EventSystem::Instance().ProcessUpToEvents<ThreadCategory::Main>(256);
 	//EventSystem::Instance().ProcessaAllEvent<ThreadCategory::Main>();
+	Core::Memory::MemoryTracker::CheckBudgets();
 	if (IsPauese()) {
 		return;
 	}
 	//Renderer Thread
-	renderer_->RequestFrame();
+	const auto now = std::chrono::steady_clock::now();
+	const std::chrono::duration<double> delta = now - last_tick_;
+	last_tick_ = now;
+	renderer_->RequestFrame({ .frame_id_ = ++frame_id_, .delta_time_ = delta.count() });
 }
 
 EngineContext::~EngineContext() {
@@ -1,5 +1,6 @@
 #ifndef SG_ENGINE_CONXTEX_H
 #define SG_ENGINE_CONXTEX_H
+#include <chrono>
 #include <memory>
 
 #include "context_base.h"
@@ -46,6 +47,9 @@ private:
 private:
 	//All Thread Class
 	std::unique_ptr<Renderer::RendererContext> renderer_;
+	//Render Snapshot
+	uint64_t frame_id_ = 0;
+	std::chrono::steady_clock::time_point last_tick_ = std::chrono::steady_clock::now();
 };
 
 } //namespace Context
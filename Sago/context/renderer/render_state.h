@@ -0,0 +1,15 @@
+#ifndef SG_RENDERER_RENDER_STATE_H
+#define SG_RENDERER_RENDER_STATE_H
+#include <cstdint>
+
+namespace Context::Renderer {
+
+//Simulation snapshot published by the main thread once per tick
+struct RenderState {
+	uint64_t frame_id_ = 0;
+	double delta_time_ = 0.0;
+};
+
+} //namespace Context::Renderer
+
+#endif
@@ -5,7 +5,6 @@
 #include "event/renderer_event_type.h"
 
 #include <atomic>
-#include <mutex>
 
 namespace Context::Renderer {
 using namespace Core::Event;
@@ -18,7 +17,7 @@ void RendererContext::InitImpl() {
 void RendererContext::ListenEventImpl() {
 	auto& dispatch = EventSystem::Instance().GetRendererDispatcher();
 	dispatch.subscribe<RenderNextFrameEvent>([&](const RenderNextFrameEvent& e) {
-		this->work_pending_ = false;
+		this->Wake();
 	});
 
 	dispatch.subscribe<SwapchainRecreateEvent>([&](const SwapchainRecreateEvent& e) {
@@ -33,20 +32,18 @@ void RendererContext::ListenEventImpl() {
 RendererContext::RendererContext(const Platform::AppWindow& window,
 	Platform::EditorUI& editor,const Controller::FrameRateController& controller) :
 		window_(window),editor_(editor),fpscontroller_(controller) {
+	//Subscribe before the render thread exists, it is the only thread that may touch
+	//the renderer dispatcher's handler lists afterwards
+	InitListenEvent();
 	//Start Thread
 	running_.store(true, std::memory_order_relaxed);
 	thread_ = std::jthread(&RendererContext::Tick, this);
 	LogInfo("[Context][Renderer] RendererContext created");
-	InitListenEvent();
 }
 
 RendererContext::~RendererContext() noexcept {
 	running_.store(false, std::memory_order_release);
-	{
-		std::lock_guard lock(mutex_);
-		work_pending_ = false;
-	}
-	work_cv_.notify_all();
+	Wake();
 
 	if (thread_.joinable()) {
 		thread_.join();
@@ -57,28 +54,18 @@ RendererContext::~RendererContext() noexcept {
 void RendererContext::PutEvent(callable_t&& callable) noexcept {
 	int write_idx = write_index_.load(std::memory_order_relaxed);
 	task_buffers_[write_idx].emplace_back(std::move(callable));
-	{
-		std::lock_guard lock(mutex_);
-		work_pending_ = true;
-	}
-	work_cv_.notify_one();
+	Wake();
 }
 
-void RendererContext::RequestFrame() noexcept {
-	{
-		std::lock_guard lock(mutex_);
-		work_pending_ = true;
-	}
-	work_cv_.notify_one();
+void RendererContext::RequestFrame(const RenderState& state) noexcept {
+	render_state_.Write() = state;
+	render_state_.Publish();
+	Wake();
 }
 
 void RendererContext::Stop() noexcept {
 	running_.store(false, std::memory_order_release);
-	{
-		std::lock_guard lock(mutex_);
-		work_pending_ = true;
-	}
-	work_cv_.notify_all();
+	Wake();
 
 	if (thread_.joinable()) {
 		thread_.join();
@@ -90,9 +77,7 @@ void RendererContext::Tick() noexcept {
 	Init(); //Delay Init
 	LogInfo("[Context][Renderer] Render thread started");
 
-	int current_read_index = 0;
-	constexpr int busy_wait_count = 1000;
-	constexpr int yield_count = 100;
+	uint64_t seen_seq = 0;
 
 	while (running_.load(std::memory_order_acquire)) {
 		//fpscontroller_.StartFrame();
@@ -105,26 +90,21 @@ void RendererContext::Tick() noexcept {
 			continue;
 		}
 
-		std::unique_lock lock(mutex_);
-		work_cv_.wait(lock, [this] {
-			return work_pending_ || !running_.load(std::memory_order_acquire);
-		});
+		wake_seq_.wait(seen_seq, std::memory_order_acquire);
+		seen_seq = wake_seq_.load(std::memory_order_acquire);
 
 		if (!running_.load(std::memory_order_acquire)) {
 			break;
 		}
 
-		work_pending_ = false;
-		lock.unlock();
-
 		// Task
 		const int task_buffer_index = write_index_.load(std::memory_order_acquire);
 		const int current_read_index = task_buffer_index ^ 1;
 		write_index_.store(current_read_index, std::memory_order_release);
 		ProcessTasks(task_buffer_index);
 
-		//Renderer
-		if (vk_context_) {
+		//Renderer: only when main published a newer snapshot
+		if (render_state_.Fetch() && vk_context_) {
 			vk_context_->Renderer();
 		}
 		//fpscontroller_.EndFrame();
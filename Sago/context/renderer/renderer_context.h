@@ -12,6 +12,7 @@
 
 //Memory
 #include "core/memory/buffer/ring_buffer.h"
+#include "core/memory/buffer/triple_buffer.h"
 #include "core/memory/lockfree/SPSC/array.h"
 
 //Controller
@@ -20,6 +21,7 @@
 #include "window/window_sdl.h"
 #include "editor/editor_imgui_init.h"
 //Vulkan
+#include "render_state.h"
 #include "vulkan_context.h"
 
 
@@ -34,6 +36,7 @@ public:
 	using callable_t = std::function<void()>;
 	using Event = Event::RendererEventType;
 	using EventQueue = Core::Memory::LockFreeArray<Event>;
+	using StateBuffer = Core::Memory::LockFreeTripleBuffer<RenderState>;
 	//using RingBuffer = Core::Memory::RingBuffer<typename T, size_t Capacity>
 
 	RendererContext(const Platform::AppWindow&,
@@ -48,14 +51,10 @@ public:
 	void PutEvent(callable_t&& callable) noexcept;
 	inline void PutEvent(Event event) {
 		event_queue_.push(event);
-		{
-			std::lock_guard lock(mutex_);
-			work_pending_ = true;
-		}
-		work_cv_.notify_one();
+		Wake();
 	}
 
-	void RequestFrame() noexcept;
+	void RequestFrame(const RenderState& state) noexcept;
 	void Stop() noexcept;
 	//CRPT
 private:
@@ -66,6 +65,10 @@ private:
 	void Tick() noexcept;
 	void HandleEvent(const Event&);
 	void ProcessTasks(int buffer_index) noexcept;
+	inline void Wake() noexcept {
+		wake_seq_.fetch_add(1, std::memory_order_release);
+		wake_seq_.notify_one();
+	}
 
 private:
 	const Platform::AppWindow& window_;
@@ -74,9 +77,9 @@ private:
 	std::atomic<bool> running_{ true };
 private:
 	std::jthread thread_;
-	std::mutex mutex_;
-	std::condition_variable work_cv_;
-	bool work_pending_ = false;
+	std::atomic<uint64_t> wake_seq_{ 0 };
+	//Main -> Renderer snapshot
+	StateBuffer render_state_;
 	//Buffer
 	std::array<std::vector<callable_t>, 2> task_buffers_;
 	std::atomic<int> write_index_{ 0 };
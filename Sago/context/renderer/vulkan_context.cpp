@@ -1,5 +1,6 @@
 #include "vulkan_context.h"
 #include "core/events/event_system.h"
+#include "core/memory/tracking/memory_tracker.h"
 
 #include <cstdint>
 #include <memory>
@@ -25,7 +26,11 @@ Platform::EditorUI& editor) :
 	vkswapchain_ = std::make_unique<VulkanSwapchain>(window_, *vkinitail_, *vksurface_, *vkdevice_);
 
 	renderpass_ = std::make_unique<RenderPass>(GetDevice(), GetSwapChain());
-	pipeline_ = std::make_unique<Pipeline>(GetDevice(), GetSwapChain(), *renderpass_);
+	//Pipelines compile in the background while the rest of startup runs
+	pipeline_cache_ = std::make_unique<VulkanPipelineCache>(GetDevice());
+	pipeline_registry_ = std::make_unique<VulkanPipelineRegistry>(GetDevice(), *pipeline_cache_);
+	pipeline_compiler_ = std::make_unique<VulkanPipelineCompiler>(*pipeline_cache_);
+	pipeline_ = std::make_unique<Pipeline>(GetDevice(), GetSwapChain(), *renderpass_, *pipeline_registry_, *pipeline_compiler_);
 
 	swapchain_framebuffer_ = std::make_unique<FrameBuffer>(VulkanFrameBuffer::CreateInfo{
 			.device = GetDevice().GetDevice(),
@@ -36,23 +41,21 @@ Platform::EditorUI& editor) :
 	});
 
 	//Asynch
-	max_frame_flight_ = vkswapchain_->GetImages().size();
 	auto indice_graphy = FindIndice(Graphy{}, vkinitail_->GetPhysicalDevice());
 	commandpool_ = std::make_unique<VulkanCommandPool>(
 			vkdevice_->GetDevice(),
 			indice_graphy.family_.value());
 
-	commands_.resize(max_frame_flight_);
-	image_available_semaphores_.resize(max_frame_flight_);
-	render_finished_semaphores_.resize(max_frame_flight_);
-	inflight_fences_.resize(max_frame_flight_);
-	for (int i = 0; i < max_frame_flight_; ++i) {
+	frame_timeline_ = std::make_unique<VulkanFrameTimeline>(vkdevice_->GetDevice());
+	commands_.resize(kFramesInFlight);
+	image_available_semaphores_.resize(kFramesInFlight);
+	for (uint32_t i = 0; i < kFramesInFlight; ++i) {
 		image_available_semaphores_[i] = std::make_unique<Semaphore>(vkdevice_->GetDevice());
-		render_finished_semaphores_[i] = std::make_unique<Semaphore>(vkdevice_->GetDevice());
 		commands_[i] = commandpool_->CreateCommand(vkdevice_->GetGraphyciQueue());
-		inflight_fences_[i] = std::make_unique<Fence>(vkdevice_->GetDevice(), VK_FENCE_CREATE_SIGNALED_BIT);
 	}
-	//images_in_flight_.resize(max_frame_flight,VK_NULL_HANDLE);
+	CreatePresentSemaphores();
+	frame_arena_ = std::make_unique<Core::Memory::FrameArena>(kFramesInFlight);
+	recorder_ = std::make_unique<Recorder>(*vkdevice_, kFramesInFlight);
 	CreateMemeoryAllocate();
 
 	//PushEvent VulkanContext Data
@@ -73,25 +76,67 @@ Platform::EditorUI& editor) :
 }
 
 void VulkanContext::Renderer() {
-	WaitForPreviousFrame();
+	const uint64_t frame = frame_timeline_->Current() + 1;
+	current_frame_ = static_cast<uint32_t>(frame % kFramesInFlight);
+	WaitForPreviousFrame(frame);
+	if constexpr (Shader::kShaderHotReload) {
+		//A stat per shader file, a few times a second is enough
+		if (frame % kHotReloadInterval == 0) {
+			pipeline_->HotReloadPipeline();
+		}
+	}
+	//Swaps in a finished compile, recording reads the pipeline from here on
+	pipeline_->PollPipeline();
+	frame_arena_->BeginFrame(current_frame_);
+	recorder_->BeginFrame(current_frame_);
 	auto [index, result] = GetImageForSwapChain();
 	if (!result) {
 		return;
 	}
-	ResetForFence();
+	//Only frames that reach Submit advance the timeline. Copies out of the
+	//partition being reused may still run on the transfer queue
+	frame_timeline_->Advance();
+	const auto partitions = staging_tickets_.size();
+	upload_manager_->Wait(staging_tickets_[frame % partitions]);
+	auto retired = staging_ring_->BeginFrame(frame);
+	//Uploads recorded since the last frame, the flushed data belongs to the previous partition
+	upload_manager_->Collect(frame_arena_->Resource());
+	const auto ticket = upload_manager_->Flush();
+	staging_tickets_[(frame - 1) % partitions] = ticket;
+	if (!retired.empty()) [[unlikely]] {
+		//Only copies read them; this frame is submitted after the batch, on a shared
+		//queue its completion covers the copies, with a dedicated one Wait finishes them
+		frame_timeline_->DeferUntil(frame, [this, ticket, buffers = std::move(retired)]() mutable {
+			upload_manager_->Wait(ticket);
+			for (auto& buffer : buffers) {
+				vma_allocator_->DestroyBuffer(buffer);
+			}
+		});
+	}
 	//Command
-	RendererCommand(index);
-	Submit();
+	const uint64_t upload_wait = RendererCommand(index);
+	//Per-frame data written while recording, visible before the GPU reads it
+	staging_ring_->Flush();
+	Submit(index, upload_wait);
 	Present(index);
-	current_frame_ = (current_frame_ + 1) % max_frame_flight_;
 }
 
-void VulkanContext::WaitForPreviousFrame() const {
-	inflight_fences_[current_frame_]->wait();
+//The last frame recorded in this slot, also runs frees deferred to finished frames
+void VulkanContext::WaitForPreviousFrame(uint64_t frame) const {
+	frame_timeline_->Wait(frame > kFramesInFlight ? frame - kFramesInFlight : 0);
 }
 
-void VulkanContext::ResetForFence() const {
-	inflight_fences_[current_frame_]->reset();
+//Present waits on them until the image is re-acquired, so one per image
+void VulkanContext::CreatePresentSemaphores() {
+	const auto image_count = vkswapchain_->GetImages().size();
+	if (render_finished_semaphores_.size() == image_count) {
+		return;
+	}
+	render_finished_semaphores_.clear();
+	render_finished_semaphores_.resize(image_count);
+	for (auto& semaphore : render_finished_semaphores_) {
+		semaphore = std::make_unique<Semaphore>(vkdevice_->GetDevice());
+	}
 }
 
 //Memory
@@ -119,42 +164,61 @@ std::pair<uint32_t, bool> VulkanContext::GetImageForSwapChain() {
 	return { imageIndex, true };
 }
 
-void VulkanContext::RendererCommand(uint32_t index) const {
+uint64_t VulkanContext::RendererCommand(uint32_t index) const {
 	using namespace Driver::Vulkan;
 	commands_[current_frame_]->Reset();
 	commands_[current_frame_]->BeginRecording();
+	//Ownership of finished streaming copies, before anything reads them
+	const uint64_t upload_wait = upload_manager_->RecordAcquires(commands_[current_frame_]->getHandle());
 	const auto& extent = vkswapchain_->GetExtent();
-	//renderer_pass
+	//renderer_pass, draws recorded into secondaries across the recorder lanes
 	CommandBuilder builder{ *commands_[current_frame_] };
-	VkBuffer vertexBuffer = vertex_buffer_.buffer;
-	VkDeviceSize offsets[] = { 0 };
-	VkBuffer indexBuffer = index_buffer_.buffer;
-	builder.BeginRenderPass(*renderpass_, swapchain_framebuffer_->Get(index), extent)
-			.BindGraphicsPipeline(*pipeline_)
-			.BindVertexBuffers(0, { vertexBuffer }, { 0 })
-			.BindIndexBuffer(indexBuffer, 0, VK_INDEX_TYPE_UINT16)
-			.SetViewport(extent)
-			.SetScissor(extent)
-			.DrawIndexed(indices.size())
-			//.Draw(3, 1, 0, 0)
-			.EndRenderPass();
+	const VkFramebuffer framebuffer = swapchain_framebuffer_->Get(index);
+	builder.BeginRenderPass(*renderpass_, framebuffer, extent, {}, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+	//Read once, the lanes only get the handle
+	const VkPipeline pipeline = pipeline_->GetPipeLine();
+	recorder_->Record(commands_[current_frame_]->getHandle(),
+			{ renderpass_->GetRenderPass(), 0, framebuffer },
+			std::span<const DrawItem>(draw_list_),
+			[&](CommandBuilder& chunk, std::span<const DrawItem> draws) {
+				chunk.BindGraphicsPipeline(pipeline)
+						.SetViewport(extent)
+						.SetScissor(extent);
+				for (const auto& draw : draws) {
+					chunk.BindVertexBuffers(0, { draw.vertex_buffer_ }, { 0 })
+							.BindIndexBuffer(draw.index_buffer_, 0, VK_INDEX_TYPE_UINT16)
+							.DrawIndexed(draw.index_count_);
+				}
+			});
+	builder.EndRenderPass();
 	//ui_pass
 	editor_.RecordRenderCommands(commands_[current_frame_]->getHandle(), index);
 	commands_[current_frame_]->EndRecording();
-	
+	return upload_wait;
 }
 
-void VulkanContext::Submit() const {
-	commands_[current_frame_]->Submit({ *image_available_semaphores_[current_frame_] },
-			{ VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT },
-			{ *render_finished_semaphores_[current_frame_] },
-			*inflight_fences_[current_frame_]);
+void VulkanContext::Submit(uint32_t index, uint64_t upload_wait) const {
+	//Signals frame N on the timeline, the present semaphore is binary
+	const VkSemaphore signal_semaphores[] = { *render_finished_semaphores_[index], frame_timeline_->GetHandle() };
+	const uint64_t signal_values[] = { 0, frame_timeline_->Current() };
+	//The transfer timeline has already reached upload_wait, the wait only orders the handoff
+	const VkSemaphore wait_semaphores[] = { *image_available_semaphores_[current_frame_], upload_manager_->GetTimeline() };
+	const VkPipelineStageFlags wait_stages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT };
+	const uint64_t wait_values[] = { 0, upload_wait };
+	const uint32_t wait_count = upload_wait == 0 ? 1 : 2;
+	commands_[current_frame_]->Submit(
+			std::span(wait_semaphores, wait_count),
+			std::span(wait_stages, wait_count),
+			std::span(wait_values, wait_count),
+			signal_semaphores, signal_values,
+			VK_NULL_HANDLE);
 }
 
 void VulkanContext::Present(uint32_t imageindex) {
+	const VkSemaphore wait_semaphores[] = { *render_finished_semaphores_[imageindex] };
 	auto&& [result, str] = commands_[current_frame_]->Present(
 			vkdevice_->GetPresentQueue(),
-			{ *render_finished_semaphores_[current_frame_] },
+			wait_semaphores,
 			*vkswapchain_,
 			imageindex);
 
@@ -172,6 +236,11 @@ void VulkanContext::Present(uint32_t imageindex) {
 
 VulkanContext::~VulkanContext() {
 	WaitForDeviceIdle();
+	//Runs every deferred free while the allocator is still alive
+	frame_timeline_.reset();
+	Core::Memory::MemoryTracker::SetGpuStatsProvider(nullptr);
+	upload_manager_.reset();
+	staging_ring_.reset();
 
 	if (vma_allocator_) {
 		vma_allocator_->DestroyBuffer(vertex_buffer_);
@@ -192,6 +261,7 @@ bool VulkanContext::ReCreazteSwapChain() {
 
 	swapchain_framebuffer_.reset();
 	vkswapchain_->RecreateSwapchain();
+	CreatePresentSemaphores();
 	
 	VkExtent2D newExtent = vkswapchain_->GetExtent();
 	if (newExtent.width == 0 || newExtent.height == 0) {
@@ -227,25 +297,35 @@ void VulkanContext::CreateMemeoryAllocate() {
 			vkinitail_->GetPhysicalDevice(),
 			config);
 
-	auto indice_graphy = FindIndice(Graphy{}, vkinitail_->GetPhysicalDevice());
+	Core::Memory::MemoryTracker::SetGpuStatsProvider([allocator = vma_allocator_.get()]() {
+		auto stats = allocator->GetMemoryStats();
+		return Core::Memory::GpuMemoryStats{
+			.allocated_bytes = stats.totalAllocatedBytes,
+			.used_bytes = stats.usedBytes,
+			.allocation_count = stats.allocationCount,
+			.budget_bytes = stats.budgetBytes
+		};
+	});
 
-	upload_manager_ = std::make_unique<UploadManager>(*vkdevice_, indice_graphy.family_.value());
+	upload_manager_ = std::make_unique<UploadManager>(*vkdevice_, *vma_allocator_);
+	staging_ring_ = std::make_unique<StagingRing>(*vma_allocator_, kFramesInFlight);
+	staging_tickets_.resize(staging_ring_->PartitionCount());
 
+	//Staging data lives in the ring's initial partition
 	//vertex
 	vertex_buffer_ = vma_allocator_->CreateVertexBuffer<Vertex>(
 			vertices.size(),
 			"TriangleVertices");
-
-	auto vertexStaging = vma_allocator_->CreateStagingBuffer(vertices, "VertexStaging");
-	upload_manager_->UploadBufferData(*vma_allocator_, vertexStaging, vertex_buffer_);
+	upload_manager_->UploadBufferData(staging_ring_->Write(vertices), vertex_buffer_);
 
 	//index
 	index_buffer_ = vma_allocator_->CreateIndexBuffer<uint16_t>(indices.size());
-	auto indexStaging = vma_allocator_->CreateStagingBuffer(indices, "IndexStaging");
-	upload_manager_->UploadBufferData(*vma_allocator_, indexStaging, index_buffer_);
+	upload_manager_->UploadBufferData(staging_ring_->Write(indices), index_buffer_);
+	draw_list_.push_back({ vertex_buffer_.buffer, index_buffer_.buffer, static_cast<uint32_t>(indices.size()) });
 
-	vma_allocator_->DestroyBuffer(vertexStaging);
-	vma_allocator_->DestroyBuffer(indexStaging);
+	//The first frame draws them, only the ownership handoff is left to it
+	staging_ring_->Flush();
+	upload_manager_->Wait(upload_manager_->Flush());
 }
 
 } //namespace Context
\ No newline at end of file
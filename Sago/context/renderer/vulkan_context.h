@@ -7,18 +7,30 @@
 #include "drivers/vulkan/commands/vk_commandbuild.h"
 #include "drivers/vulkan/commands/vk_commandpool.h"
 #include "drivers/vulkan/commands/vk_fence.h"
+#include "drivers/vulkan/commands/vk_frame_timeline.h"
+#include "drivers/vulkan/commands/vk_parallel_recorder.h"
 #include "drivers/vulkan/commands/vk_semaphore.h"
 #include "drivers/vulkan/extensions/vk_surface.h"
 #include "drivers/vulkan/extensions/vk_swapchain.h"
+#include "drivers/vulkan/pipelines/vk_pipeline_cache.h"
+#include "drivers/vulkan/pipelines/vk_pipeline_compiler.h"
+#include "drivers/vulkan/pipelines/vk_pipeline_registry.h"
 #include "drivers/vulkan/pipelines/vk_pipeline_simple.h"
 #include "drivers/vulkan/renderpass/vk_frambuffer.h"
 #include "drivers/vulkan/renderpass/vk_renderpass_simple.h"
 #include "drivers/vulkan/vk_device.h"
 #include "drivers/vulkan/vk_instance.h"
 //memory
+#include "core/memory/arena/frame_arena.h"
 #include "drivers/vulkan/commands/vk_upload_manager.h"
+#include "drivers/vulkan/memory/vk_staging_ring.h"
 #include "drivers/vulkan/memory/vk_vma_allocator.h"
 
+//Frames the CPU may record ahead of the GPU, independent of the swapchain image count
+#if !defined(SAGA_FRAMES_IN_FLIGHT)
+	#define SAGA_FRAMES_IN_FLIGHT 2
+#endif
+
 namespace Context {
 
 class VulkanContext {
@@ -26,6 +38,11 @@ public:
 	void Renderer();
 
 public:
+	static constexpr uint32_t kFramesInFlight = SAGA_FRAMES_IN_FLIGHT;
+	static_assert(kFramesInFlight == 2 || kFramesInFlight == 3, "SAGA_FRAMES_IN_FLIGHT must be 2 or 3");
+	//Frames between checks for changed shaders, with SAGA_SHADER_HOT_RELOAD
+	static constexpr uint64_t kHotReloadInterval = 30;
+
 	using FrameBuffer = Driver::Vulkan::VulkanFrameBuffer;
 	using RenderPass = Driver::Vulkan::VulkanSimpleRenderPass;
 	using Pipeline = Driver::Vulkan::VulkanSimplePipeline;
@@ -39,8 +56,17 @@ public:
 
 	auto& GetDevice() { return *vkdevice_; }
 	auto& GetSwapChain() { return *vkswapchain_; }
+	auto& GetUploadManager() { return *upload_manager_; }
+	auto& GetPipelineCompiler() { return *pipeline_compiler_; }
+	auto& GetPipelineRegistry() { return *pipeline_registry_; }
+	//Per-frame uploads and dynamic data, one memcpy and no allocation
+	auto& GetStagingRing() { return *staging_ring_; }
 
 	void WaitForDeviceIdle() const{ vkDeviceWaitIdle(*vkdevice_); }
+	//Per-frame scratch, valid until this frame slot comes around again
+	Core::Memory::FrameArena& GetFrameArena() { return *frame_arena_; }
+	//"GPU done with frame N" and deferred frees for every subsystem
+	Driver::Vulkan::VulkanFrameTimeline& GetFrameTimeline() { return *frame_timeline_; }
 
 private:
 	const Platform::AppWindow& window_;
@@ -51,7 +77,10 @@ private:
 	std::unique_ptr<Driver::Vulkan::VulkanSwapchain> vkswapchain_;
 	//RenderPass
 	std::unique_ptr<RenderPass> renderpass_;
-	//Pipeline
+	//Pipeline, the cache and compiler outlive every pipeline built with them
+	std::unique_ptr<Driver::Vulkan::VulkanPipelineCache> pipeline_cache_;
+	std::unique_ptr<Driver::Vulkan::VulkanPipelineRegistry> pipeline_registry_;
+	std::unique_ptr<Driver::Vulkan::VulkanPipelineCompiler> pipeline_compiler_;
 	std::unique_ptr<Pipeline> pipeline_;
 	//FrameBuffer
 	std::unique_ptr<FrameBuffer> swapchain_framebuffer_;
@@ -61,21 +90,23 @@ public:
 	std::atomic<bool> renderer_paused_{ false };
 
 private:
-	uint32_t current_frame_{};
-	uint32_t max_frame_flight_{};
+	uint32_t current_frame_{}; //slot of the frame being recorded
 	//Asynch
 	using Command = Driver::Vulkan::VulkanCommand;
 	using Pool = Driver::Vulkan::VulkanCommandPool;
 	//Command
 	std::unique_ptr<Pool> commandpool_;
 	std::vector<std::unique_ptr<Command>> commands_;
+	//Per-lane, per-slot pools for the scene's secondaries
+	using Recorder = Driver::Vulkan::VulkanParallelRecorder;
+	std::unique_ptr<Recorder> recorder_;
 
 private:
 	using Semaphore = Driver::Vulkan::VulkanSemaphore;
-	using Fence = Driver::Vulkan::VulkanFence;
-	std::vector<std::unique_ptr<Semaphore>> image_available_semaphores_;
-	std::vector<std::unique_ptr<Semaphore>> render_finished_semaphores_;
-	std::vector<std::unique_ptr<Fence>> inflight_fences_;
+	std::unique_ptr<Driver::Vulkan::VulkanFrameTimeline> frame_timeline_;
+	std::vector<std::unique_ptr<Semaphore>> image_available_semaphores_; //per slot
+	std::vector<std::unique_ptr<Semaphore>> render_finished_semaphores_; //per swapchain image
+	std::unique_ptr<Core::Memory::FrameArena> frame_arena_;
 
 private:
 	void Clear();
@@ -85,21 +116,33 @@ private:
 	//std::expected<uint32_t, bool>GetImageForSwapChain_();
 	std::pair<uint32_t, bool> GetImageForSwapChain();
 	void Present(uint32_t);
-	void WaitForPreviousFrame() const;
-	void ResetForFence() const;
-	void RendererCommand(uint32_t) const;
-	void Submit() const;
+	void WaitForPreviousFrame(uint64_t) const;
+	void CreatePresentSemaphores();
+	uint64_t RendererCommand(uint32_t) const;
+	void Submit(uint32_t, uint64_t) const;
 
 private:
 	using VmaAlloactor = Driver::Vulkan::Memory::VulkanAllocator;
 	using Buffer = Driver::Vulkan::Memory::VulkanAllocator::Buffer;
 	using UploadManager = Driver::Vulkan::VulkanUploadManager;
+	using StagingRing = Driver::Vulkan::Memory::VulkanStagingRing;
 	//Memory
 	std::unique_ptr<VmaAlloactor> vma_allocator_;
+	std::unique_ptr<StagingRing> staging_ring_;
+	//Per ring partition, the upload batch that copies out of it
+	std::vector<Driver::Vulkan::UploadTicket> staging_tickets_;
 	std::unique_ptr<UploadManager> upload_manager_;
 	void CreateMemeoryAllocate();
 	Buffer vertex_buffer_;
 	Buffer index_buffer_;
+
+	//Scene draw list, split across the recorder lanes in order
+	struct DrawItem {
+		VkBuffer vertex_buffer_;
+		VkBuffer index_buffer_;
+		uint32_t index_count_;
+	};
+	std::vector<DrawItem> draw_list_;
 };
 
 } //namespace Context
@@ -153,7 +153,11 @@ public:
 	}
 
 	void sync() {
-		std::for_each(thread_list_.begin(), thread_list_.end(), [](std::thread& t) { t.join(); });
+		std::for_each(thread_list_.begin(), thread_list_.end(), [](std::thread& t) {
+			if (t.joinable()) {
+				t.join();
+			}
+		});
 	}
 
 	void force_stop() {
@@ -168,7 +172,12 @@ public:
 
 	void force_stop_gracefully() {
 		is_started_ = false;
-		is_stop_ = true;
+		{
+			//Under the lock, a worker between its predicate check and the wait would miss it
+			std::lock_guard<std::mutex> lock(thread_lock_);
+			is_stop_ = true;
+		}
+		cv_.notify_all();
 		this->sync();
 	}
 
@@ -0,0 +1,112 @@
+#ifndef SG_EVENT_BUS_H
+#define SG_EVENT_BUS_H
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "event_dispatcher.h"
+
+namespace Core::Event {
+
+enum class ThreadCategory {
+	Main,
+	Renderer,
+	Physical
+};
+
+//One thread-affine dispatcher on the bus
+template <ThreadCategory Category, typename Dispatcher>
+struct DispatcherBinding {
+	static constexpr ThreadCategory category = Category;
+	using dispatcher_type = Dispatcher;
+};
+
+/**
+ * @brief Routes events to the dispatchers registered at compile time
+ * Publish<Category> targets one thread. Broadcast reaches every dispatcher whose type
+ * list contains the event: the event is written once into a pooled EventPayload and
+ * each queue gets a reference, so fan-out costs one pointer push per subscriber.
+ */
+template <typename... Bindings>
+class EventBus {
+	static constexpr std::array<ThreadCategory, sizeof...(Bindings)> kCategories = { Bindings::category... };
+
+	template <ThreadCategory Category>
+	static constexpr size_t IndexOf() {
+		for (size_t i = 0; i < kCategories.size(); ++i) {
+			if (kCategories[i] == Category) {
+				return i;
+			}
+		}
+		return kCategories.size();
+	}
+
+	std::tuple<typename Bindings::dispatcher_type...> dispatchers_;
+
+public:
+	template <ThreadCategory Category>
+	auto& Get() {
+		constexpr size_t idx = IndexOf<Category>();
+		static_assert(idx < sizeof...(Bindings), "No dispatcher registered for this ThreadCategory");
+		return std::get<idx>(dispatchers_);
+	}
+
+	template <ThreadCategory Category, typename Event>
+	bool Publish(Event&& event) {
+		return Get<Category>().publish(std::forward<Event>(event));
+	}
+
+	//Number of dispatchers that can receive Event
+	template <typename Event>
+	static constexpr size_t SubscriberCount() {
+		return (size_t(Bindings::dispatcher_type::template accepts<std::decay_t<Event>>()) + ...);
+	}
+
+	//Returns how many dispatchers queued the event
+	template <typename Event>
+	size_t Broadcast(Event&& event) {
+		using EventT = std::decay_t<Event>;
+		constexpr size_t subscribers = SubscriberCount<EventT>();
+		static_assert(subscribers > 0, "No dispatcher accepts this event type");
+
+		size_t delivered = 0;
+		if constexpr (subscribers == 1) {
+			std::apply([&](auto&... dispatchers) {
+				//Only one dispatcher takes the event, so forwarding in the fold moves it once
+				(PublishIfAccepted(dispatchers, std::forward<Event>(event), delivered), ...);
+			},
+					dispatchers_);
+		} else {
+			auto* payload = EventPayload<EventT>::Create(static_cast<uint32_t>(subscribers), std::forward<Event>(event));
+			if (payload == nullptr) [[unlikely]] {
+				return 0;
+			}
+			std::apply([&](auto&... dispatchers) {
+				(ShareIfAccepted(dispatchers, payload, delivered), ...);
+			},
+					dispatchers_);
+		}
+		return delivered;
+	}
+
+private:
+	template <typename Dispatcher, typename Event>
+	static void PublishIfAccepted(Dispatcher& dispatcher, Event&& event, size_t& delivered) {
+		if constexpr (Dispatcher::template accepts<std::decay_t<Event>>()) {
+			delivered += dispatcher.publish(std::forward<Event>(event)) ? 1 : 0;
+		}
+	}
+
+	template <typename Dispatcher, typename Event>
+	static void ShareIfAccepted(Dispatcher& dispatcher, EventPayload<Event>* payload, size_t& delivered) {
+		if constexpr (Dispatcher::template accepts<Event>()) {
+			delivered += dispatcher.publishShared(payload) ? 1 : 0;
+		}
+	}
+};
+
+} //namespace Core::Event
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef SG_EVENT_COALESCE_H
+#define SG_EVENT_COALESCE_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#include "context/renderer/event/renderer_event_type.h"
+#include "core/util/spain_lock.h"
+#include "event_types.h"
+
+namespace Core::Event {
+
+enum class CoalescePolicy : uint8_t {
+	kKeepAll = 0, //every event is queued
+	kKeepLatest = 1, //a newer event replaces the pending one
+	kAccumulate = 2 //merged into the pending one with Merge()
+};
+
+template <typename Event>
+struct EventCoalesce {
+	static constexpr CoalescePolicy policy = CoalescePolicy::kKeepAll;
+};
+
+template <>
+struct EventCoalesce<WindowResizeEvent> {
+	static constexpr CoalescePolicy policy = CoalescePolicy::kKeepLatest;
+};
+
+//Only the newest extent matters, the renderer recreates once per drain
+template <>
+struct EventCoalesce<Context::Renderer::Event::SwapchainRecreateEvent> {
+	static constexpr CoalescePolicy policy = CoalescePolicy::kKeepLatest;
+};
+
+template <>
+struct EventCoalesce<MouseMotionEvent> {
+	static constexpr CoalescePolicy policy = CoalescePolicy::kAccumulate;
+	static void Merge(MouseMotionEvent& pending, const MouseMotionEvent& next) noexcept {
+		const int32_t rel_x = pending.rel_x + next.rel_x;
+		const int32_t rel_y = pending.rel_y + next.rel_y;
+		pending = next; //latest position and buttons
+		pending.rel_x = rel_x;
+		pending.rel_y = rel_y;
+	}
+};
+
+template <typename Event>
+inline constexpr bool is_coalesced_v = EventCoalesce<Event>::policy != CoalescePolicy::kKeepAll;
+
+/**
+ * @brief Single pending event for kKeepLatest / kAccumulate types
+ * Same push/consume shape as LockFreeMpscRing, but holds at most one event, so a
+ * flood of motion or resize events costs one dispatch per drain.
+ */
+template <typename Event>
+class CoalescedQueue {
+public:
+	template <typename U>
+	bool push(U&& event) {
+		std::lock_guard lock(lock_);
+		if constexpr (EventCoalesce<Event>::policy == CoalescePolicy::kAccumulate) {
+			if (pending_.load(std::memory_order_relaxed)) {
+				EventCoalesce<Event>::Merge(value_, event);
+				return true;
+			}
+		}
+		value_ = std::forward<U>(event);
+		pending_.store(true, std::memory_order_release);
+		return true;
+	}
+
+	template <typename F>
+	size_t consume(F&& fn, size_t max_items = 1) {
+		if (max_items == 0 || !pending_.load(std::memory_order_acquire)) {
+			return 0;
+		}
+		Event event;
+		{
+			std::lock_guard lock(lock_);
+			event = std::move(value_);
+			pending_.store(false, std::memory_order_relaxed);
+		}
+		fn(event);
+		return 1;
+	}
+
+	size_t size() const noexcept { return pending_.load(std::memory_order_acquire) ? 1 : 0; }
+	bool empty() const noexcept { return size() == 0; }
+
+private:
+	util::SpinLock lock_;
+	std::atomic<bool> pending_{ false };
+	Event value_{};
+};
+
+} //namespace Core::Event
+
+#endif
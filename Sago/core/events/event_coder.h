@@ -3,44 +3,35 @@
 
 #include "SDL3/SDL_events.h"
 #include "event_types.h"
-#include <functional>
-#include <optional>
-#include <unordered_map>
+#include <type_traits>
+#include <utility>
 
 namespace Core::Event {
 
+/**
+ * @brief SDL_Event -> engine event
+ * A plain switch over the SDL event type, compiled into a jump table. The event is
+ * built in place and handed straight to the sink, so nothing is wrapped in an
+ * optional or a variant. Types the variant does not register are dropped at compile time.
+ */
 template <typename EventVariant>
 class EventCoder {
 private:
     using EventMap = EventTypeMap<EventVariant>;
-    using EncoderFunc = std::function<std::optional<EventVariant>(const SDL_Event&)>;
-    using EncoderTable = std::unordered_map<uint32_t, EncoderFunc>;
 
-    static std::optional<EventVariant> encode_window_event(const SDL_WindowEvent& wevent) {
-        switch (wevent.type) {
-            case SDL_EVENT_WINDOW_RESIZED:
-                return WindowResizeEvent{ wevent.data1, wevent.data2, wevent.windowID };
-            case SDL_EVENT_WINDOW_MINIMIZED:
-                return WindowMinimizeEvent{ true, wevent.windowID };
-            case SDL_EVENT_WINDOW_RESTORED:
-                return WindowMinimizeEvent{ false, wevent.windowID };
-            default:
-                return std::nullopt;
-        }
-    }
+    template <typename Event>
+    static constexpr bool accepts_v = EventMap::template contains<Event>();
 
-    static std::optional<EventVariant> encode_key_event(const SDL_KeyboardEvent& kevent) {
-        switch (kevent.type) {
-            case SDL_EVENT_KEY_DOWN:
-                return KeyEvent{ kevent.key, true, kevent.timestamp };
-            case SDL_EVENT_KEY_UP:
-                return KeyEvent{ kevent.key, false, kevent.timestamp };
-            default:
-                return std::nullopt;
+    template <typename Event, typename Sink>
+    static bool emit(Sink& sink, Event&& event) {
+        if constexpr (accepts_v<std::decay_t<Event>>) {
+            return sink(std::forward<Event>(event));
+        } else {
+            return false;
         }
     }
 
-    static std::optional<EventVariant> encode_mouse_motion(const SDL_MouseMotionEvent& motion) {
+    static MouseMotionEvent encode_mouse_motion(const SDL_MouseMotionEvent& motion) {
         MouseMotionEvent event{};
         event.timestamp = motion.timestamp;
         event.x_ = motion.x;
@@ -51,7 +42,7 @@ private:
         return event;
     }
 
-    static std::optional<EventVariant> encode_mouse_button(const SDL_MouseButtonEvent& button) {
+    static MouseButtonEvent encode_mouse_button(const SDL_MouseButtonEvent& button) {
         MouseButtonEvent event{};
         event.timestamp = button.timestamp;
         event.x_ = button.x;
@@ -79,51 +70,33 @@ private:
     }
 
 public:
-    static std::optional<EventVariant> encode(const SDL_Event& sdl_event) {
-        static const EncoderTable encoder_table = build_encoder_table();
-        
-        auto it = encoder_table.find(sdl_event.type);
-        if (it != encoder_table.end()) {
-            return it->second(sdl_event);
+    //sink(Event&&) -> bool, called with the concrete event type
+    template <typename Sink>
+    static bool encode(const SDL_Event& sdl_event, Sink&& sink) {
+        switch (sdl_event.type) {
+            case SDL_EVENT_WINDOW_RESIZED:
+                return emit(sink, WindowResizeEvent{ sdl_event.window.data1, sdl_event.window.data2, sdl_event.window.windowID });
+            case SDL_EVENT_WINDOW_MINIMIZED:
+                return emit(sink, WindowMinimizeEvent{ true, sdl_event.window.windowID });
+            case SDL_EVENT_WINDOW_RESTORED:
+                return emit(sink, WindowMinimizeEvent{ false, sdl_event.window.windowID });
+            case SDL_EVENT_KEY_DOWN:
+                return emit(sink, KeyEvent{ sdl_event.key.key, true, sdl_event.key.timestamp });
+            case SDL_EVENT_KEY_UP:
+                return emit(sink, KeyEvent{ sdl_event.key.key, false, sdl_event.key.timestamp });
+            case SDL_EVENT_MOUSE_MOTION:
+                return emit(sink, encode_mouse_motion(sdl_event.motion));
+            case SDL_EVENT_MOUSE_BUTTON_DOWN:
+            case SDL_EVENT_MOUSE_BUTTON_UP:
+                return emit(sink, encode_mouse_button(sdl_event.button));
+            case SDL_EVENT_QUIT:
+            case SDL_EVENT_MOUSE_WHEEL:
+            default:
+                return false;
         }
-        return std::nullopt;
-    }
-
-private:
-    static EncoderTable build_encoder_table() {
-        EncoderTable table;
-
-        table[SDL_EVENT_WINDOW_RESIZED] = table[SDL_EVENT_WINDOW_MINIMIZED] =
-                table[SDL_EVENT_WINDOW_RESTORED] = [](const SDL_Event& e) {
-                    return encode_window_event(e.window);
-                };
-
-        table[SDL_EVENT_KEY_DOWN] = table[SDL_EVENT_KEY_UP] = [](const SDL_Event& e) {
-            return encode_key_event(e.key);
-        };
-
-        table[SDL_EVENT_MOUSE_MOTION] = [](const SDL_Event& e) {
-            return encode_mouse_motion(e.motion);
-        };
-
-        table[SDL_EVENT_MOUSE_BUTTON_DOWN] = table[SDL_EVENT_MOUSE_BUTTON_UP] = [](const SDL_Event& e) {
-            return encode_mouse_button(e.button);
-        };
-
-        table[SDL_EVENT_QUIT] = [](const SDL_Event& e) {
-            return std::nullopt;
-        };
-
-        table[SDL_EVENT_MOUSE_WHEEL] = [](const SDL_Event& e) {
-            return std::nullopt;
-        };
-
-        
-
-        return table;
     }
 };
 
 } // namespace Core::Event
 
-#endif
\ No newline at end of file
+#endif
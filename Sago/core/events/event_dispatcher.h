@@ -1,100 +1,176 @@
 #ifndef SG_EVENT_DISPATCHER_H
 #define SG_EVENT_DISPATCHER_H
+#include "event_coalesce.h"
 #include "event_coder.h"
+#include "event_payload.h"
 #include <algorithm>
 #include <array>
 #include <atomic>
 #include <cstddef>
-#include <functional>
+#include <cstdint>
 #include <tuple>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "context/renderer/event/renderer_event_type.h"
+#include "core/memory/lockfree/MPSC/ring.h"
+#include "core/memory/tracking/memory_tracker.h"
+#include "core/util/delegate.h"
 namespace Core::Event {
-//MPSC
+
+//Stable handle returned by subscribe, stale after unsubscribe
+struct Subscription {
+	static constexpr uint32_t kInvalidType = UINT32_MAX;
+
+	uint32_t type_ = kInvalidType;
+	uint32_t slot_ = 0;
+	uint32_t generation_ = 0;
+
+	explicit operator bool() const noexcept { return type_ != kInvalidType; }
+};
+
+/**
+ * @brief MPSC event dispatcher
+ * Every event type has its own ring and handler array, so a drain is one tight loop
+ * per type over homogeneous slots, with no variant visit per event. Handlers are
+ * small-buffer delegates and never allocate. Order is kept within a type, not across types:
+ * direct and broadcast events of a type share one ring.
+ * Types with an EventCoalesce policy are merged at publish time (see event_coalesce.h).
+ * Subscribe/unsubscribe on the draining thread; during a drain both are deferred to its end.
+ */
 template <typename... EventTypes>
 class EventDispatcher {
 private:
 	using EventVariant = std::variant<EventTypes...>;
 	using EventMap = EventTypeMap<EventVariant>;
+	using SDLEncoder = EventCoder<EventVariant>;
 
-	static constexpr size_t MAX_HANDLERS_PER_TYPE = 32;
-	static constexpr size_t MAX_QUEUE_SIZE = 1024;
-
-	static_assert((MAX_QUEUE_SIZE & (MAX_QUEUE_SIZE - 1)) == 0, "MAX_QUEUE_SIZE must be power of 2");
-	static_assert((MAX_HANDLERS_PER_TYPE & (MAX_HANDLERS_PER_TYPE - 1)) == 0, "MAX_HANDLERS_PER_TYPE must be power of 2");
-	
-	static constexpr size_t QUEUE_MASK = MAX_QUEUE_SIZE - 1;
+	static constexpr size_t MAX_QUEUE_SIZE = 1024; //per event type
+	static constexpr uint32_t kNoDense = UINT32_MAX;
+	static constexpr uint32_t kPendingDense = UINT32_MAX - 1;
 
 private:
 	template <typename Event>
-	using HandlerVariant = std::variant<
-			void (*)(const Event&),
-			std::function<void(const Event&)>>;
+	using Handler = util::Delegate<void(const Event&)>;
 
+	struct SlotEntry {
+		uint32_t dense_ = kNoDense;
+		uint32_t generation_ = 0;
+	};
+
+	template <typename T>
+	using EventVector = std::vector<T, Memory::TrackedAllocator<T, Memory::MemoryTag::kEvent>>;
+
+	//Dense handler array + generation-checked slot map
+	template <typename Event>
+	struct HandlerList {
+		EventVector<Handler<Event>> handlers_;
+		EventVector<uint8_t> alive_;
+		EventVector<uint32_t> owner_slot_; //dense -> slot
+		EventVector<SlotEntry> slots_; //slot -> dense
+		EventVector<uint32_t> free_slots_;
+		//Deferred while draining
+		EventVector<uint32_t> removed_;
+		EventVector<std::pair<uint32_t, Handler<Event>>> added_;
+	};
+
+	//A published event by value, or a broadcast as its pooled payload shared with other dispatchers
 	template <typename Event>
-	using HandlerArray = std::array<HandlerVariant<Event>, MAX_HANDLERS_PER_TYPE>;
+	using QueuedEvent = std::variant<Event, EventPayload<Event>*>;
 
-	std::tuple<HandlerArray<EventTypes>...> handlers_;
+	//Coalesced types keep one pending event instead of a ring
+	template <typename Event>
+	using EventQueue = std::conditional_t<is_coalesced_v<Event>,
+			CoalescedQueue<Event>,
+			Memory::LockFreeMpscRing<QueuedEvent<Event>, MAX_QUEUE_SIZE>>;
 
-	std::array<size_t, sizeof...(EventTypes)> handler_counts_{};
-	//Right Buffer
-	std::array<EventVariant, MAX_QUEUE_SIZE> event_queue_;
-	std::atomic<size_t> queue_head_{ 0 };
-	std::atomic<size_t> queue_tail_{ 0 };
+	std::tuple<HandlerList<EventTypes>...> handlers_;
+	//Ring Buffer per type: any thread publishes, the owning thread drains
+	std::tuple<EventQueue<EventTypes>...> queues_;
 	std::atomic<bool> processing_{ false };
 
-	EventCoder<EventVariant> sdl_encoder_;
 
 public:
-	//No Capture Lambda
-	template <typename Event>
-	bool subscribe(void (*handler)(const Event&)) {
+	//Function pointer or lambda, stored inline
+	template <typename Event, typename Callable>
+	Subscription subscribe(Callable&& handler) {
 		static_assert((std::is_same_v<Event, EventTypes> || ...),
 				"Event type not registered");
 
 		constexpr size_t idx = EventMap::template index_of<Event>();
 		static_assert(idx < sizeof...(EventTypes), "Event index out of range");
 
-		size_t& count = handler_counts_[idx];
+		auto& list = std::get<idx>(handlers_);
+		uint32_t slot = 0;
+		if (!list.free_slots_.empty()) {
+			slot = list.free_slots_.back();
+			list.free_slots_.pop_back();
+		} else {
+			slot = static_cast<uint32_t>(list.slots_.size());
+			list.slots_.emplace_back();
+		}
 
-		if (count < MAX_HANDLERS_PER_TYPE) {
-			std::get<idx>(handlers_)[count++] = handler;
-			return true;
+		Handler<Event> delegate(std::forward<Callable>(handler));
+		if (processing_.load(std::memory_order_relaxed)) {
+			list.slots_[slot].dense_ = kPendingDense;
+			list.added_.emplace_back(slot, std::move(delegate));
+		} else {
+			attachHandler(list, slot, std::move(delegate));
 		}
-		return false;
+		return Subscription{ static_cast<uint32_t>(idx), slot, list.slots_[slot].generation_ };
 	}
-	//Lambda Capture &
-	template <typename Event, typename Callable>
-	bool subscribe(Callable&& handler) {
-		static_assert((std::is_same_v<Event, EventTypes> || ...),
-				"Event type not registered");
 
-		constexpr size_t idx = EventMap::template index_of<Event>();
-		static_assert(idx < sizeof...(EventTypes), "Event index out of range");
-
-		size_t& count = handler_counts_[idx];
+	template <typename Event>
+	Subscription subscribe(void (*handler)(const Event&)) {
+		return subscribe<Event, void (*)(const Event&)>(std::move(handler));
+	}
 
-		if (count < MAX_HANDLERS_PER_TYPE) {
-			std::get<idx>(handlers_)[count++] = std::function<void(const Event&)>(std::forward<Callable>(handler));
-			return true;
+	//O(1); false if the token is stale or already removed
+	bool unsubscribe(Subscription subscription) {
+		if (subscription.type_ >= sizeof...(EventTypes)) {
+			return false;
 		}
-		return false;
+		return (this->*kUnsubscribeTable[subscription.type_])(subscription);
+	}
+
+	template <typename Event>
+	size_t getHandlerCount() const {
+		constexpr size_t idx = EventMap::template index_of<Event>();
+		const auto& list = std::get<idx>(handlers_);
+		return list.handlers_.size() - list.removed_.size() + list.added_.size();
 	}
 
 	template <typename Event>
 	bool publish(Event&& event) {
-		size_t head = queue_head_.load(std::memory_order_acquire);
-		size_t tail = queue_tail_.load(std::memory_order_relaxed);
+		using EventT = std::decay_t<Event>;
+		static_assert((std::is_same_v<EventT, EventTypes> || ...),
+				"Event type not registered");
 
-		if ((tail - head) == MAX_QUEUE_SIZE) {
-			return false; // fill
+		constexpr size_t idx = EventMap::template index_of<EventT>();
+		return std::get<idx>(queues_).push(std::forward<Event>(event));
+	}
+
+	//Takes over one reference of payload, whether or not it was queued
+	template <typename Event>
+	bool publishShared(EventPayload<Event>* payload) {
+		constexpr size_t idx = EventMap::template index_of<Event>();
+		if constexpr (is_coalesced_v<Event>) {
+			const bool published = std::get<idx>(queues_).push(payload->event_);
+			payload->Release();
+			return published;
+		} else {
+			if (std::get<idx>(queues_).push(payload)) {
+				return true;
+			}
+			payload->Release();
+			return false;
 		}
+	}
 
-		event_queue_[tail & QUEUE_MASK] = std::forward<Event>(event);
-		queue_tail_.store(tail + 1, std::memory_order_release);
-		return true;
+	template <typename Event>
+	static constexpr bool accepts() {
+		return EventMap::template contains<Event>();
 	}
 
 	//Batch
@@ -106,38 +182,13 @@ public:
 	}
 
 	bool publishSDL(const SDL_Event& sdl_event) {
-		if (auto variant = sdl_encoder_.encode(sdl_event)) {
-			return publish(std::move(*variant));
-		}
-		return false;
+		return SDLEncoder::encode(sdl_event, [this](auto&& event) {
+			return this->publish(std::forward<decltype(event)>(event));
+		});
 	}
 
 	void processAllEvents() {
-		if (processing_.exchange(true, std::memory_order_acquire)) {
-			return;
-		}
-
-		const size_t head = queue_head_.load(std::memory_order_acquire);
-		const size_t tail = queue_tail_.load(std::memory_order_acquire);
-		const size_t count = tail - head;
-
-		if (count == 0) {
-			processing_.store(false, std::memory_order_release);
-			return;
-		}
-
-		auto processor = [this](const auto& event) {
-			using EventT = std::decay_t<decltype(event)>;
-			this->processSingleEvent<EventT>(event);
-		};
-
-		for (size_t i = 0; i < count; ++i) {
-			size_t index = (head + i) & QUEUE_MASK;
-			std::visit(processor, event_queue_[index]);
-		}
-
-		queue_head_.store(tail, std::memory_order_release);
-		processing_.store(false, std::memory_order_release);
+		processUpTo(getQueueSize());
 	}
 
 	size_t processUpTo(size_t max_events) {
@@ -145,35 +196,26 @@ public:
 			return 0;
 		}
 
-		const size_t head = queue_head_.load(std::memory_order_acquire);
-		const size_t tail = queue_tail_.load(std::memory_order_acquire);
-		const size_t total_count = tail - head;
-		const size_t process_count = (std::min)(max_events, total_count);
-
-		auto processor = [this](const auto& event) {
-			using EventT = std::decay_t<decltype(event)>;
-			this->processSingleEvent<EventT>(event);
-		};
-
-		for (size_t i = 0; i < process_count; ++i) {
-			size_t index = (head + i) & QUEUE_MASK;
-			std::visit(processor, event_queue_[index]);
-		}
+		size_t processed = 0;
+		((processed += drainQueue<EventTypes>(max_events - processed)), ...);
+		(flushHandlers<EventTypes>(), ...);
 
-		queue_head_.store(head + process_count, std::memory_order_release);
 		processing_.store(false, std::memory_order_release);
-
-		return process_count;
+		return processed;
 	}
 
 	size_t getQueueSize() const {
-		size_t head = queue_head_.load(std::memory_order_acquire);
-		size_t tail = queue_tail_.load(std::memory_order_acquire);
-		return tail - head;
+		auto sum = [](const auto&... queues) {
+			return (queues.size() + ... + size_t(0));
+		};
+		return std::apply(sum, queues_);
 	}
 
 	bool isQueueFull() const {
-		return getQueueSize() >= MAX_QUEUE_SIZE;
+		return std::apply([](const auto&... queues) {
+			return ((queues.size() >= MAX_QUEUE_SIZE) || ...);
+		},
+				queues_);
 	}
 
 	bool isQueueEmpty() const {
@@ -181,27 +223,119 @@ public:
 	}
 
 	static constexpr size_t getMaxQueueSize() { return MAX_QUEUE_SIZE; }
-	static constexpr size_t getMaxHandlersPerType() { return MAX_HANDLERS_PER_TYPE; }
 
 private:
 	template <typename Event>
-	void processSingleEvent(const Event& event) {
-		constexpr size_t idx = EventMap::template index_of<Event>();
-		static_assert(idx < sizeof...(EventTypes), "Event index out of range");
+	static void attachHandler(HandlerList<Event>& list, uint32_t slot, Handler<Event>&& handler) {
+		list.slots_[slot].dense_ = static_cast<uint32_t>(list.handlers_.size());
+		list.handlers_.push_back(std::move(handler));
+		list.alive_.push_back(1);
+		list.owner_slot_.push_back(slot);
+	}
 
-		const auto& handler_array = std::get<idx>(handlers_);
-		const size_t count = handler_counts_[idx];
+	//Swap-remove from the dense array
+	template <typename Event>
+	static void detachHandler(HandlerList<Event>& list, uint32_t slot) {
+		const uint32_t dense = list.slots_[slot].dense_;
+		const uint32_t last = static_cast<uint32_t>(list.handlers_.size() - 1);
+		if (dense != last) {
+			list.handlers_[dense] = std::move(list.handlers_[last]);
+			list.alive_[dense] = list.alive_[last];
+			list.owner_slot_[dense] = list.owner_slot_[last];
+			list.slots_[list.owner_slot_[dense]].dense_ = dense;
+		}
+		list.handlers_.pop_back();
+		list.alive_.pop_back();
+		list.owner_slot_.pop_back();
+		list.slots_[slot].dense_ = kNoDense;
+		list.free_slots_.push_back(slot);
+	}
+
+	template <typename Event>
+	bool unsubscribeTyped(Subscription subscription) {
+		constexpr size_t idx = EventMap::template index_of<Event>();
+		auto& list = std::get<idx>(handlers_);
+		if (subscription.slot_ >= list.slots_.size()) {
+			return false;
+		}
+		SlotEntry& entry = list.slots_[subscription.slot_];
+		if (entry.generation_ != subscription.generation_ || entry.dense_ == kNoDense) {
+			return false;
+		}
+		++entry.generation_;
+
+		if (entry.dense_ == kPendingDense) {
+			//Subscribed and removed within the same drain
+			auto it = std::find_if(list.added_.begin(), list.added_.end(),
+					[slot = subscription.slot_](const auto& added) { return added.first == slot; });
+			list.added_.erase(it);
+			entry.dense_ = kNoDense;
+			list.free_slots_.push_back(subscription.slot_);
+		} else if (processing_.load(std::memory_order_relaxed)) {
+			list.alive_[entry.dense_] = 0;
+			list.removed_.push_back(subscription.slot_);
+		} else {
+			detachHandler(list, subscription.slot_);
+		}
+		return true;
+	}
 
-		if (count == 0) [[unlikely]] {
+	template <typename Event>
+	void flushHandlers() {
+		constexpr size_t idx = EventMap::template index_of<Event>();
+		auto& list = std::get<idx>(handlers_);
+		if (list.removed_.empty() && list.added_.empty()) [[likely]] {
 			return;
 		}
+		for (uint32_t slot : list.removed_) {
+			detachHandler(list, slot);
+		}
+		list.removed_.clear();
+		for (auto& [slot, handler] : list.added_) {
+			attachHandler(list, slot, std::move(handler));
+		}
+		list.added_.clear();
+	}
+
+	using UnsubscribeFn = bool (EventDispatcher::*)(Subscription);
+	static constexpr std::array<UnsubscribeFn, sizeof...(EventTypes)> kUnsubscribeTable = {
+		&EventDispatcher::template unsubscribeTyped<EventTypes>...
+	};
+
+	//Stops at the first slot a producer has claimed but not filled yet
+	template <typename Event>
+	size_t drainQueue(size_t budget) {
+		if (budget == 0) {
+			return 0;
+		}
+		constexpr size_t idx = EventMap::template index_of<Event>();
+		auto& queue = std::get<idx>(queues_);
+		const auto& list = std::get<idx>(handlers_);
+		const size_t count = list.handlers_.size();
+
+		//Adds are deferred, so these pointers stay valid for the whole drain
+		const Handler<Event>* handlers = list.handlers_.data();
+		const uint8_t* alive = list.alive_.data();
+		auto dispatch = [handlers, alive, count](const Event& event) {
+			for (size_t i = 0; i < count; ++i) {
+				if (alive[i]) [[likely]] {
+					handlers[i](event);
+				}
+			}
+		};
 
-		for (size_t i = 0; i < count; ++i) {
-			std::visit([&event](auto&& handler) {
-				if (handler) {
-					handler(event);
+		if constexpr (is_coalesced_v<Event>) {
+			return queue.consume(dispatch, budget);
+		} else {
+			return queue.consume([&dispatch](const QueuedEvent<Event>& queued) {
+				if (auto* const* payload = std::get_if<EventPayload<Event>*>(&queued)) {
+					dispatch((*payload)->event_);
+					(*payload)->Release();
+				} else {
+					dispatch(*std::get_if<Event>(&queued));
 				}
-			},handler_array[i]);
+			},
+					budget);
 		}
 	}
 };
@@ -221,6 +355,7 @@ using RendererEventDispatcher = EventDispatcher<
 		Context::Renderer::Event::RenderFrameEvent,
 		Context::Renderer::Event::RenderNextFrameEvent,
 		Context::Renderer::Event::RendererPauseEvent>;
+
 } //namespace Core::Event
 
 
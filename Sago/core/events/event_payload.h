@@ -0,0 +1,46 @@
+#ifndef SG_EVENT_PAYLOAD_H
+#define SG_EVENT_PAYLOAD_H
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+#include "core/memory/pool/free_list.h"
+
+namespace Core::Event {
+
+/**
+ * @brief Ref-counted event shared by several dispatchers
+ * A broadcast writes the event once into a pooled payload and every dispatcher queues
+ * a pointer to it; the last drain to release it returns it to the pool.
+ */
+template <typename Event>
+struct EventPayload {
+	std::atomic<uint32_t> refs_;
+	Event event_;
+
+	template <typename U>
+	EventPayload(uint32_t refs, U&& event) :
+			refs_(refs), event_(std::forward<U>(event)) {}
+
+	template <typename U>
+	static EventPayload* Create(uint32_t refs, U&& event) {
+		return Pool().New(refs, std::forward<U>(event));
+	}
+
+	void Release() noexcept {
+		if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			Pool().Delete(this);
+		}
+	}
+
+private:
+	//Kept until process exit, dispatchers are drained during static teardown
+	static Memory::ObjectPool<EventPayload, 256, Memory::MemoryTag::kEvent>& Pool() {
+		static auto* pool = new Memory::ObjectPool<EventPayload, 256, Memory::MemoryTag::kEvent>();
+		return *pool;
+	}
+};
+
+} //namespace Core::Event
+
+#endif
@@ -1,97 +1,70 @@
 #ifndef SG_EVENT_SYSTEM_H
 #define SG_EVENT_SYSTEM_H
 #include "common/single_internal.h"
-#include "event_dispatcher.h"
+#include "event_bus.h"
 #include <utility>
 
 namespace Core::Event {
-enum class ThreadCategory {
-	Main,
-	Renderer,
-	Physical
-};
+
+//Bind a dispatcher together with the thread that drains it, an undrained
+//queue keeps every broadcast payload it was handed
+using EngineEventBus = EventBus<
+		DispatcherBinding<ThreadCategory::Main, GameEventDispatcher>,
+		DispatcherBinding<ThreadCategory::Renderer, RendererEventDispatcher>>;
 
 class EventSystem : public Common::Singleton<EventSystem, Common::GlobalSingetonTag> {
 	friend class Common::Singleton<EventSystem, Common::GlobalSingetonTag>;
 	DEFINE_CLASS_SINGLTEN(EventSystem);
 
 private:
-	GameEventDispatcher main_dispatcher_;
-	RendererEventDispatcher renderer_dispatcher_;
+	EngineEventBus bus_;
+
 public:
-	GameEventDispatcher& GetMainDispatcher(){return main_dispatcher_;}
-	RendererEventDispatcher& GetRendererDispatcher(){return renderer_dispatcher_;}
+	GameEventDispatcher& GetMainDispatcher() { return bus_.Get<ThreadCategory::Main>(); }
+	RendererEventDispatcher& GetRendererDispatcher() { return bus_.Get<ThreadCategory::Renderer>(); }
+
+	template <ThreadCategory Category>
+	auto& GetDispatcher() { return bus_.Get<Category>(); }
+
+	EngineEventBus& GetBus() { return bus_; }
 
 public:
-	//broad
+	//broad: every dispatcher that registers Event, one pooled payload
 	template <typename Event>
-	void BroadAllCast(Event&& event) {
-		publishEvent<ThreadCategory::Main, Event>(std::forward<Event>(event));
-		publishEvent<ThreadCategory::Renderer, Event>(std::forward<Event>(event));
+	size_t BroadAllCast(Event&& event) {
+		return bus_.Broadcast(std::forward<Event>(event));
 	}
 
 	//Publish
-	template <ThreadCategory Category= ThreadCategory::Main, typename Event>
-	void PublishEvent(Event&& event) {
-		if constexpr (Category == ThreadCategory::Main) {
-			main_dispatcher_.publish(std::forward<Event>(event));
-		}
-
-		if constexpr (Category == ThreadCategory::Renderer) {
-			renderer_dispatcher_.publish(std::forward<Event>(event));
-		}
+	template <ThreadCategory Category = ThreadCategory::Main, typename Event>
+	bool PublishEvent(Event&& event) {
+		return bus_.Publish<Category>(std::forward<Event>(event));
 	}
 
 	//Batch Publish
 	template <ThreadCategory Category = ThreadCategory::Main, typename... Events>
-	void PublishEventBulk(Events&&... events) {
-		if constexpr (Category == ThreadCategory::Main) {
-			main_dispatcher_.publishBulk(std::forward<Events>(events)...);
-		}
-
-		if constexpr (Category == ThreadCategory::Renderer) {
-			renderer_dispatcher_.publishBulk(std::forward<Events>(events)...);
-		}
+	size_t PublishEventBulk(Events&&... events) {
+		return bus_.Get<Category>().publishBulk(std::forward<Events>(events)...);
 	}
 
 	//SDL
 	template <ThreadCategory Category = ThreadCategory::Main>
-	void PublishSDLEvent(const SDL_Event& sdl_event) {
-		if constexpr (Category == ThreadCategory::Main) {
-			main_dispatcher_.publishSDL(sdl_event);
-		}
-
-		if constexpr (Category == ThreadCategory::Renderer) {
-			renderer_dispatcher_.publishSDL(sdl_event);
-		}
+	bool PublishSDLEvent(const SDL_Event& sdl_event) {
+		return bus_.Get<Category>().publishSDL(sdl_event);
 	}
 
 	//Process
-	template <ThreadCategory Category= ThreadCategory::Main>
+	template <ThreadCategory Category = ThreadCategory::Main>
 	void ProcessaAllEvent() {
-		if constexpr (Category == ThreadCategory::Main) {
-			main_dispatcher_.processAllEvents();
-		}
-
-		if constexpr (Category == ThreadCategory::Renderer) {
-			renderer_dispatcher_.processAllEvents();
-		}
+		bus_.Get<Category>().processAllEvents();
 	}
 
 	template <ThreadCategory Category = ThreadCategory::Main>
-	void ProcessUpToEvents(size_t max_events) {
-		if constexpr (Category == ThreadCategory::Main) {
-			main_dispatcher_.processUpTo(max_events);
-		}
-
-		if constexpr (Category == ThreadCategory::Renderer) {
-			renderer_dispatcher_.processUpTo(max_events);
-		}
+	size_t ProcessUpToEvents(size_t max_events) {
+		return bus_.Get<Category>().processUpTo(max_events);
 	}
-
-public:
 };
 
 } //namespace Core::Event
 
-#endif
\ No newline at end of file
+#endif
@@ -32,6 +32,11 @@ struct EventTypeMap<std::variant<Events...>> {
 		return index_of_type_v<Event, Events...>;
 	}
 
+	template <typename Event>
+	static constexpr bool contains() {
+		return (std::is_same_v<Event, Events> || ...);
+	}
+
 	template <size_t I>
 	using type_at = std::tuple_element_t<I, std::tuple<Events...>>;
 };
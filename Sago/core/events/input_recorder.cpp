@@ -0,0 +1,206 @@
+#include "input_recorder.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/io/log/log.h"
+
+namespace Core::Event {
+
+uint32_t InputRecorder::RecordSize(uint32_t type) noexcept {
+	if (type >= SDL_EVENT_WINDOW_FIRST && type <= SDL_EVENT_WINDOW_LAST) {
+		return sizeof(SDL_WindowEvent);
+	}
+	switch (type) {
+		case SDL_EVENT_KEY_DOWN:
+		case SDL_EVENT_KEY_UP:
+			return sizeof(SDL_KeyboardEvent);
+		case SDL_EVENT_MOUSE_MOTION:
+			return sizeof(SDL_MouseMotionEvent);
+		case SDL_EVENT_MOUSE_BUTTON_DOWN:
+		case SDL_EVENT_MOUSE_BUTTON_UP:
+			return sizeof(SDL_MouseButtonEvent);
+		case SDL_EVENT_MOUSE_WHEEL:
+			return sizeof(SDL_MouseWheelEvent);
+		default:
+			return 0;
+	}
+}
+
+bool InputRecorder::IsInput(uint32_t type) noexcept {
+	switch (type) {
+		case SDL_EVENT_KEY_DOWN:
+		case SDL_EVENT_KEY_UP:
+		case SDL_EVENT_MOUSE_MOTION:
+		case SDL_EVENT_MOUSE_BUTTON_DOWN:
+		case SDL_EVENT_MOUSE_BUTTON_UP:
+		case SDL_EVENT_MOUSE_WHEEL:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool InputRecorder::StartRecording(const std::string& path) {
+	Stop();
+	file_ = std::fopen(path.c_str(), "wb");
+	if (file_ == nullptr) {
+		LogWarring("[Event][Input] Failed to open record file {}", path);
+		return false;
+	}
+	const FileHeader header{};
+	std::fwrite(&header, sizeof(header), 1, file_);
+
+	ring_ = std::make_unique<std::byte[]>(kRingSize);
+	write_pos_.store(0, std::memory_order_relaxed);
+	read_pos_.store(0, std::memory_order_relaxed);
+	dropped_.store(0, std::memory_order_relaxed);
+	frame_ = 0;
+	mode_ = Mode::kRecord;
+	flusher_ = std::jthread([this](std::stop_token token) { FlushLoop(token); });
+	LogInfo("[Event][Input] Recording input to {}", path);
+	return true;
+}
+
+bool InputRecorder::StartReplay(const std::string& path) {
+	Stop();
+	std::FILE* file = std::fopen(path.c_str(), "rb");
+	if (file == nullptr) {
+		LogWarring("[Event][Input] Failed to open replay file {}", path);
+		return false;
+	}
+
+	FileHeader header{};
+	if (std::fread(&header, sizeof(header), 1, file) != 1 || header.magic_ != kMagic ||
+			header.version_ != kVersion || header.sdl_event_size_ != sizeof(SDL_Event)) {
+		LogWarring("[Event][Input] {} is not a compatible input log", path);
+		std::fclose(file);
+		return false;
+	}
+
+	replay_.clear();
+	RecordHeader record{};
+	while (std::fread(&record, sizeof(record), 1, file) == 1) {
+		if (record.size_ > sizeof(SDL_Event)) {
+			LogWarring("[Event][Input] Corrupt record in {}, replay truncated", path);
+			break;
+		}
+		ReplayEvent& replay = replay_.emplace_back();
+		replay.frame_ = record.frame_;
+		std::memset(&replay.event_, 0, sizeof(SDL_Event));
+		if (std::fread(&replay.event_, record.size_, 1, file) != 1) {
+			replay_.pop_back();
+			break;
+		}
+	}
+	std::fclose(file);
+
+	cursor_ = 0;
+	frame_ = 0;
+	mode_ = Mode::kReplay;
+	LogInfo("[Event][Input] Replaying {} events from {}", replay_.size(), path);
+	return true;
+}
+
+void InputRecorder::Stop() {
+	if (mode_ == Mode::kRecord) {
+		flusher_.request_stop();
+		flush_signal_.fetch_add(1, std::memory_order_release);
+		flush_signal_.notify_one();
+		if (flusher_.joinable()) {
+			flusher_.join();
+		}
+		FlushPending();
+		std::fclose(file_);
+		file_ = nullptr;
+		ring_.reset();
+		if (const auto dropped = dropped_.load(std::memory_order_relaxed); dropped != 0) {
+			LogWarring("[Event][Input] {} events dropped, ring buffer was full", dropped);
+		}
+	}
+	replay_.clear();
+	cursor_ = 0;
+	mode_ = Mode::kOff;
+}
+
+bool InputRecorder::Capture(const SDL_Event& event) {
+	if (mode_ == Mode::kOff) [[likely]] {
+		return true;
+	}
+	if (mode_ == Mode::kReplay) {
+		return !IsInput(event.type); //live input is replaced by the log
+	}
+	const uint32_t size = RecordSize(event.type);
+	if (size == 0) {
+		return true;
+	}
+
+	const RecordHeader record{ static_cast<uint32_t>(frame_), size };
+	const size_t bytes = sizeof(record) + size;
+	const size_t write = write_pos_.load(std::memory_order_relaxed);
+	if (kRingSize - (write - read_pos_.load(std::memory_order_acquire)) < bytes) [[unlikely]] {
+		dropped_.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+	WriteRing(write, &record, sizeof(record));
+	WriteRing(write + sizeof(record), &event, size);
+	write_pos_.store(write + bytes, std::memory_order_release);
+	return true;
+}
+
+void InputRecorder::BeginFrame(InjectFn inject) {
+	if (mode_ == Mode::kRecord) {
+		//Wake the flusher every 64 frames, or early once a quarter of the ring is pending
+		const size_t pending = write_pos_.load(std::memory_order_relaxed) - read_pos_.load(std::memory_order_relaxed);
+		if (pending >= kRingSize / 4 || (pending != 0 && (frame_ & 63) == 0)) {
+			flush_signal_.fetch_add(1, std::memory_order_release);
+			flush_signal_.notify_one();
+		}
+	} else if (mode_ == Mode::kReplay) {
+		//Events stamped N arrived after BeginFrame N - 1, live they are drained in frame N
+		while (cursor_ < replay_.size() && replay_[cursor_].frame_ <= frame_) {
+			if (IsInput(replay_[cursor_].event_.type)) {
+				inject(replay_[cursor_].event_);
+			}
+			++cursor_;
+		}
+	}
+	++frame_;
+}
+
+void InputRecorder::WriteRing(size_t position, const void* data, size_t bytes) {
+	const size_t begin = position & (kRingSize - 1);
+	const size_t first = (std::min)(bytes, kRingSize - begin);
+	std::memcpy(ring_.get() + begin, data, first);
+	if (first < bytes) {
+		std::memcpy(ring_.get(), static_cast<const std::byte*>(data) + first, bytes - first);
+	}
+}
+
+void InputRecorder::FlushLoop(std::stop_token token) {
+	uint32_t seen = flush_signal_.load(std::memory_order_acquire);
+	while (!token.stop_requested()) {
+		flush_signal_.wait(seen, std::memory_order_acquire);
+		seen = flush_signal_.load(std::memory_order_acquire);
+		FlushPending();
+	}
+}
+
+void InputRecorder::FlushPending() {
+	const size_t read = read_pos_.load(std::memory_order_relaxed);
+	const size_t write = write_pos_.load(std::memory_order_acquire);
+	if (read == write) {
+		return;
+	}
+	const size_t begin = read & (kRingSize - 1);
+	const size_t bytes = write - read;
+	const size_t first = (std::min)(bytes, kRingSize - begin);
+	std::fwrite(ring_.get() + begin, 1, first, file_);
+	if (first < bytes) {
+		std::fwrite(ring_.get(), 1, bytes - first, file_);
+	}
+	std::fflush(file_);
+	read_pos_.store(write, std::memory_order_release);
+}
+
+} //namespace Core::Event
@@ -0,0 +1,106 @@
+#ifndef SG_EVENT_INPUT_RECORDER_H
+#define SG_EVENT_INPUT_RECORDER_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SDL3/SDL_events.h"
+#include "common/single_internal.h"
+
+namespace Core::Event {
+
+/**
+ * @brief Records SDL input per frame and replays it at the same frame boundaries
+ * Record: the main thread copies each input event into a byte ring, a background
+ * thread flushes it to a compact binary log. Replay: the log is loaded up front and
+ * BeginFrame re-injects exactly the events that arrived before the matching frame.
+ * Only input/window events are kept; events carrying pointers (text, drop) are skipped.
+ * Replay takes over key and mouse input only, live window events still get through
+ * and recorded ones are not re-injected, so the real window's size and state win.
+ */
+class InputRecorder : public Common::Singleton<InputRecorder> {
+	friend class Common::Singleton<InputRecorder>;
+
+public:
+	enum class Mode : uint8_t {
+		kOff = 0,
+		kRecord = 1,
+		kReplay = 2
+	};
+
+	using InjectFn = void (*)(const SDL_Event&);
+
+	static constexpr uint32_t kMagic = 0x52494753; //"SGIR"
+	static constexpr uint32_t kVersion = 1;
+	static constexpr size_t kRingSize = size_t(1) << 20;
+
+	struct FileHeader {
+		uint32_t magic_ = kMagic;
+		uint32_t version_ = kVersion;
+		uint32_t sdl_event_size_ = sizeof(SDL_Event);
+		uint32_t reserved_ = 0;
+	};
+
+	struct RecordHeader {
+		uint32_t frame_;
+		uint32_t size_; //bytes of SDL_Event that follow
+	};
+
+public:
+	bool StartRecording(const std::string& path);
+	bool StartReplay(const std::string& path);
+	void Stop();
+
+	Mode GetMode() const noexcept { return mode_; }
+	uint64_t GetFrame() const noexcept { return frame_; }
+	uint64_t GetDroppedCount() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+	bool IsReplayFinished() const noexcept { return mode_ == Mode::kReplay && cursor_ >= replay_.size(); }
+
+	//Main thread, per SDL event. false: drop the live event (replay owns input)
+	bool Capture(const SDL_Event& event);
+	//Main thread, once per frame before the event drain
+	void BeginFrame(InjectFn inject);
+
+	//0: not recorded
+	static uint32_t RecordSize(uint32_t type) noexcept;
+	//Key and mouse events, the ones replay replaces
+	static bool IsInput(uint32_t type) noexcept;
+
+private:
+	InputRecorder() = default;
+	~InputRecorder() { Stop(); }
+
+	void FlushLoop(std::stop_token token);
+	void FlushPending();
+	void WriteRing(size_t position, const void* data, size_t bytes);
+
+private:
+	Mode mode_ = Mode::kOff;
+	uint64_t frame_ = 0;
+
+	//Record
+	std::FILE* file_ = nullptr;
+	std::unique_ptr<std::byte[]> ring_;
+	alignas(64) std::atomic<size_t> write_pos_{ 0 };
+	alignas(64) std::atomic<size_t> read_pos_{ 0 };
+	std::atomic<uint64_t> dropped_{ 0 };
+	std::atomic<uint32_t> flush_signal_{ 0 };
+	std::jthread flusher_;
+
+	//Replay
+	struct ReplayEvent {
+		uint32_t frame_;
+		SDL_Event event_;
+	};
+	std::vector<ReplayEvent> replay_;
+	size_t cursor_ = 0;
+};
+
+} //namespace Core::Event
+
+#endif
@@ -1,81 +1,144 @@
 #include "log.h"
 
-#include <atomic>
+#include "log_sink.h"
+#include "core/memory/tracking/memory_tracker.h"
+
 #include <chrono>
-#include <ctime>
-#include <filesystem>
-#include <mutex>
-#include <queue>
-#include <sstream>
+#include <iterator>
 #include <utility>
 
 namespace Core::Log {
 
-void AsyncLog::PrintPolicy(LogPolicy policy, std::string&& str) const {
-	switch (policy) {
-		case LogPolicy::kSimple: {
-			std::cout << str + Color::RESET + '\n';
-		} break;
-		case LogPolicy::kDetail: {
-			auto now = std::chrono::system_clock::now();
-			auto in_time_t = std::chrono::system_clock::to_time_t(now);
-			std::tm tm_buf;
-
-#ifdef _WIN32
-			localtime_s(&tm_buf, &in_time_t);
-#else
-			localtime_r(&in_time_t, &tm_buf);
-#endif
-			std::ostringstream ss;
-			ss << std::put_time(&tm_buf, "[%Y-%m-%d %H:%M:%S]");
-			std::cout << str + "---------------->" + ss.str() + Color::RESET + '\n';
-		} break;
+namespace {
+
+constexpr LogSite kDroppedSite{ "{} log messages dropped", __FILE__, __LINE__,
+	LogRank::kWarring, LogPolicy::kSimple, LogCategory::kGeneral };
+
+} //namespace
+
+AsyncLog::AsyncLog() {
+	text_.reserve(LogRecord::kArgCapacity * 2);
+	sinks_.push_back(std::make_unique<ConsoleSink>());
+	consumer_ = std::thread(&AsyncLog::LogLoop, this);
+}
+
+AsyncLog::~AsyncLog() noexcept {
+	running_.store(false, std::memory_order_release);
+	pending_.fetch_add(1, std::memory_order_release);
+	pending_.notify_one();
+	if (consumer_.joinable()) {
+		consumer_.join();
 	}
+	DrainAll();
 }
 
-void AsyncLog::LogLoop() {
-	std::queue<std::pair<LogPolicy, std::string>> local_queue;
-	
-	while (running_.load(std::memory_order_acquire)) {
-		msg_count_.wait(0, std::memory_order_acquire);
-		{
-			std::unique_lock lock(spinlock_);
-			std::swap(log_queue_, local_queue);
-		}
-		while (!local_queue.empty()) {
-			PrintPolicy(local_queue.front().first, std::move(local_queue.front().second));
-			local_queue.pop();
+ThreadLogRing& AsyncLog::LocalRing() {
+	thread_local RingHolder holder;
+	if (!holder.ring_) [[unlikely]] {
+		holder.ring_ = std::allocate_shared<ThreadLogRing>(Memory::TrackedAllocator<ThreadLogRing, Memory::MemoryTag::kLog>{});
+		std::lock_guard lock(rings_mutex_);
+		rings_.push_back(holder.ring_);
+	}
+	return *holder.ring_;
+}
+
+LogRecord* AsyncLog::Reserve() noexcept {
+	auto& ring = LocalRing();
+	LogRecord* record = ring.Reserve();
+	while (record == nullptr) [[unlikely]] {
+		if (overflow_.load(std::memory_order_relaxed) == LogOverflow::kDrop ||
+				!running_.load(std::memory_order_acquire)) {
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
 		}
+		pending_.fetch_add(1, std::memory_order_release);
+		pending_.notify_one();
+		std::this_thread::yield();
+		record = ring.Reserve();
+	}
+	return record;
+}
 
-		msg_count_.store(0, std::memory_order_release);
+void AsyncLog::Commit() noexcept {
+	LocalRing().Commit();
+	if (pending_.fetch_add(1, std::memory_order_release) == 0) {
+		pending_.notify_one();
 	}
 }
 
-void AsyncLog::Log(std::string&& str) {
-	{
-		std::unique_lock lock(spinlock_);
-		log_queue_.push({ LogPolicy::kSimple, std::move(str) });
+void AsyncLog::AddSink(std::unique_ptr<LogSink> sink) {
+	std::lock_guard lock(sinks_mutex_);
+	sinks_.push_back(std::move(sink));
+}
+
+void AsyncLog::ClearSinks() {
+	std::lock_guard lock(sinks_mutex_);
+	for (auto& sink : sinks_) {
+		sink->Flush();
 	}
+	sinks_.clear();
+}
 
-	if (msg_count_.fetch_add(1, std::memory_order_release) == 0) {
-		msg_count_.notify_one();
+void AsyncLog::WriteRecord(const LogSite& site, int64_t timestamp_ns, std::string_view text) {
+	const LogEntry entry{ &site, timestamp_ns, clock_.WallTextAt(timestamp_ns), text };
+	for (auto& sink : sinks_) {
+		sink->Write(entry);
 	}
 }
 
-void AsyncLog::LogDetail(std::string_view color, std::string_view filename, int codeline, std::string&& str) {
+size_t AsyncLog::DrainAll() {
+	size_t drained = 0;
+	std::lock_guard sinks_lock(sinks_mutex_);
+	//One clock sample per batch turns the records' ticks into time
+	clock_.Update();
+	//Drained from a copy, a thread's first log call registers its ring without waiting on the sinks
 	{
-		std::unique_lock lock(spinlock_);
-		auto msg = std::format("{}[{}:{}] {}",
-				color,
-				std::filesystem::path(filename).filename().string(),
-				codeline,
-				str);
-		log_queue_.push({ LogPolicy::kDetail, std::move(msg) });
+		std::lock_guard lock(rings_mutex_);
+		drain_rings_.assign(rings_.begin(), rings_.end());
+	}
+	bool retired = false;
+	for (auto& ring : drain_rings_) {
+		drained += ring->Drain([this](const LogRecord& record) {
+			text_.clear();
+			record.format_(text_, record.site_->format_, record.args_);
+			WriteRecord(*record.site_, clock_.ToMonotonicNs(record.ticks_), text_);
+		});
+		retired |= ring->retired_.load(std::memory_order_acquire);
+	}
+	drain_rings_.clear();
+	if (retired) [[unlikely]] {
+		//Rings of exited threads
+		std::lock_guard lock(rings_mutex_);
+		std::erase_if(rings_, [](const std::shared_ptr<ThreadLogRing>& ring) {
+			return ring->retired_.load(std::memory_order_acquire) && ring->Empty();
+		});
 	}
+	if (const auto dropped = dropped_.exchange(0, std::memory_order_relaxed); dropped != 0) {
+		text_.clear();
+		std::format_to(std::back_inserter(text_), "{} log messages dropped", dropped);
+		WriteRecord(kDroppedSite, clock_.MonotonicNs(), text_);
+	}
+	for (auto& sink : sinks_) {
+		sink->Flush();
+	}
+	return drained;
+}
 
-	if (msg_count_.fetch_add(1, std::memory_order_release) == 0) {
-		msg_count_.notify_one();
+void AsyncLog::LogLoop() {
+	uint32_t idle_polls = 0;
+	while (running_.load(std::memory_order_acquire)) {
+		pending_.store(0, std::memory_order_release);
+		if (DrainAll() != 0) {
+			idle_polls = 0;
+		} else if (++idle_polls >= kParkAfterPolls) {
+			//Parked: the next Commit pays one wake-up
+			pending_.wait(0, std::memory_order_acquire);
+			idle_polls = 0;
+			continue;
+		}
+		//Polling while logs flow keeps the futex off the callers' path
+		std::this_thread::sleep_for(kFlushInterval);
 	}
 }
 
-} //namespace Core::Log
\ No newline at end of file
+} //namespace Core::Log
@@ -1,20 +1,41 @@
 #ifndef SG_LOG_H
 #define SG_LOG_H
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cassert>
-#include <condition_variable>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <format>
-#include <iostream>
-#include <queue>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <thread>
+#include <tuple>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "common/single_internal.h"
+#include "core/time/coarse_clock.h"
 #include "core/util/dll_export.h"
-#include "core/util/spain_lock.h"
+#include "log_ring.h"
+
+#define SGLOG_LEVEL_TRACE 0
+#define SGLOG_LEVEL_DEBUG 1
+#define SGLOG_LEVEL_INFO 2
+#define SGLOG_LEVEL_WARN 3
+#define SGLOG_LEVEL_ERROR 4
+#define SGLOG_LEVEL_OFF 5
+
+//Set by SAGA_LOG_LEVEL in CMake
+#if !defined(LOG_ACTIVE_LEVEL)
+	#define LOG_ACTIVE_LEVEL SGLOG_LEVEL_INFO
+#endif
 
 namespace Core::Log {
 
@@ -42,6 +63,83 @@ enum class LogPolicy : short {
 	kDetail = 1
 };
 
+enum class LogCategory : uint8_t {
+	kGeneral = 0,
+	kVulkan,
+	kEvent,
+	kInput,
+	kMemory,
+	kContext,
+	kCount
+};
+
+constexpr int RankLevel(LogRank rank) noexcept {
+	switch (rank) {
+		case LogRank::kWarring:
+			return SGLOG_LEVEL_WARN;
+		case LogRank::kError:
+			return SGLOG_LEVEL_ERROR;
+		default:
+			return SGLOG_LEVEL_INFO;
+	}
+}
+
+//Ranks below LOG_ACTIVE_LEVEL compile to nothing, their arguments are never evaluated
+template <LogRank rk>
+inline constexpr bool kRankCompiled = RankLevel(rk) >= LOG_ACTIVE_LEVEL;
+
+/**
+ * @brief Runtime level per category
+ * Checked at the call site before any argument is evaluated. Defaults to
+ * SGLOG_LEVEL_TRACE, so only the compile-time level applies until raised.
+ */
+class LogFilter {
+public:
+	static void SetLevel(LogCategory category, int level) noexcept {
+		levels_[static_cast<size_t>(category)].store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+	}
+
+	static void SetLevel(int level) noexcept {
+		for (auto& category_level : levels_) {
+			category_level.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+		}
+	}
+
+	static int GetLevel(LogCategory category) noexcept {
+		return levels_[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+	}
+
+	static bool Enabled(LogCategory category, LogRank rank) noexcept {
+		return RankLevel(rank) >= GetLevel(category);
+	}
+
+private:
+	static inline std::array<std::atomic<uint8_t>, static_cast<size_t>(LogCategory::kCount)> levels_{};
+};
+
+/**
+ * @brief Per call site limiter, "at most N per second"
+ * The window is shared by all threads hitting the site; a racing reset may let a
+ * few extra records through, which is fine for logs.
+ */
+class LogRateLimit {
+public:
+	bool Acquire(uint32_t per_second) noexcept {
+		const int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+				std::chrono::steady_clock::now().time_since_epoch())
+									.count();
+		int64_t window = window_.load(std::memory_order_relaxed);
+		if (window != now && window_.compare_exchange_strong(window, now, std::memory_order_relaxed)) {
+			count_.store(0, std::memory_order_relaxed);
+		}
+		return count_.fetch_add(1, std::memory_order_relaxed) < per_second;
+	}
+
+private:
+	std::atomic<int64_t> window_{ -1 };
+	std::atomic<uint32_t> count_{ 0 };
+};
+
 template <LogRank rk>
 concept ValidLogRank = (rk == LogRank::kInfo || rk == LogRank::kWarring || rk == LogRank::kError || rk == LogRank::kVulkanLayer);
 
@@ -66,119 +164,262 @@ consteval auto PolicySelect(LogPolicy po) {
 	return po;
 }
 
-//read log todo..
-// class AsyncDoubleBufferLog : public util::DoubleBuffer<AsyncDoubleBufferLog, std::string> {
-// public:
-// public:
-// 	void Push(const std::string& item);
-// 	std::vector<std::string>& Swap();
-// };
+class LogSink;
+
+enum class LogOverflow : uint8_t {
+	kDrop = 0, //count and drop, never stall the caller
+	kBlock = 1 //yield until the log thread frees a slot
+};
 
-//cmd
+/**
+ * @brief Async logger
+ * Every logging thread owns a ThreadLogRing of fixed-size records and writes into it
+ * in place; no lock, no heap. The log thread drains all rings, formats each record
+ * and hands it to every LogSink, then flushes the sinks once per batch.
+ */
 class SAGA_API AsyncLog : public Common::Singleton<AsyncLog> {
 	friend class Common::Singleton<AsyncLog>;
 
 private:
-	std::queue<std::pair<LogPolicy, std::string>> log_queue_;
-	std::atomic<bool> running_;
+	struct RingHolder {
+		std::shared_ptr<ThreadLogRing> ring_;
+		~RingHolder() {
+			if (ring_) {
+				ring_->retired_.store(true, std::memory_order_release);
+			}
+		}
+	};
+
+	static constexpr std::chrono::milliseconds kFlushInterval{ 1 };
+	static constexpr uint32_t kParkAfterPolls = 200;
+
+	std::atomic<bool> running_{ true };
+	std::atomic<uint32_t> pending_{ 0 };
+	std::atomic<uint64_t> dropped_{ 0 };
+	std::atomic<LogOverflow> overflow_{ LogOverflow::kDrop };
+
+	std::mutex rings_mutex_;
+	std::vector<std::shared_ptr<ThreadLogRing>> rings_;
+
+	//Log thread only, under sinks_mutex_
+	std::mutex sinks_mutex_;
+	std::vector<std::unique_ptr<LogSink>> sinks_;
+	std::string text_;
+	std::vector<std::shared_ptr<ThreadLogRing>> drain_rings_; //rings_ copied per batch
+	Time::CoarseClock clock_;
+
 	std::thread consumer_;
-	util::SpinLock spinlock_;
-	std::atomic<int> msg_count_{ 0 };
 
-	AsyncLog() :
-			consumer_(&AsyncLog::LogLoop, this) {
-		running_.store(true, std::memory_order_release);
-	}
+	AsyncLog();
+	~AsyncLog() noexcept;
 
-	~AsyncLog() noexcept {
-		running_.store(false, std::memory_order_release);
-		spinlock_.lock();
-		while (!log_queue_.empty()) {
-			std::string msg;
-			msg = std::move(log_queue_.front().second);
-			std::cout << msg;
-			log_queue_.pop();
-		}
-		spinlock_.unlock();
-		if (consumer_.joinable()) {
-			consumer_.join();
+	ThreadLogRing& LocalRing();
+	size_t DrainAll();
+	void WriteRecord(const LogSite& site, int64_t timestamp_ns, std::string_view text);
+
+public:
+	void LogLoop();
+
+	//Producer side: fill the returned record, then Commit(). nullptr: dropped
+	LogRecord* Reserve() noexcept;
+	void Commit() noexcept;
+
+	//Console output is installed by default
+	void AddSink(std::unique_ptr<LogSink> sink);
+	void ClearSinks();
+
+	void SetOverflowPolicy(LogOverflow policy) noexcept { overflow_.store(policy, std::memory_order_relaxed); }
+	uint64_t GetDroppedCount() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+};
+
+namespace Detail {
+
+//Strings are copied into the record; everything else must be trivially copyable
+template <typename T>
+concept LogStringArg = std::is_convertible_v<const T&, std::string_view>;
+
+template <typename T>
+concept LogValueArg = std::is_trivially_copyable_v<T> && !LogStringArg<T>;
+
+template <typename T>
+using LogStored = std::conditional_t<LogStringArg<std::remove_cvref_t<T>>, std::string_view, std::remove_cvref_t<T>>;
+
+//String: uint16_t length + bytes, value: raw bytes
+template <typename T>
+constexpr size_t kLogFixedBytes = std::is_same_v<T, std::string_view> ? sizeof(uint16_t) : sizeof(T);
+
+class LogArgWriter {
+public:
+	LogArgWriter(std::byte* cursor, size_t slack) noexcept :
+			cursor_(cursor), slack_(slack) {}
+
+	template <typename T>
+	void Put(const T& arg) noexcept {
+		if constexpr (LogStringArg<T>) {
+			std::string_view str;
+			if constexpr (std::is_pointer_v<T>) {
+				str = arg != nullptr ? std::string_view(arg) : std::string_view();
+			} else {
+				str = std::string_view(arg);
+			}
+			//Strings share the slack left after the fixed-size args, truncate past it
+			const auto length = static_cast<uint16_t>((std::min)({ str.size(), slack_, size_t(UINT16_MAX) }));
+			if (length < str.size()) [[unlikely]] {
+				PutTruncated(str, length);
+				return;
+			}
+			slack_ -= length;
+			std::memcpy(cursor_, &length, sizeof(length));
+			if (length != 0) {
+				std::memcpy(cursor_ + sizeof(length), str.data(), length);
+			}
+			cursor_ += sizeof(length) + length;
+		} else {
+			std::memcpy(cursor_, &arg, sizeof(T));
+			cursor_ += sizeof(T);
 		}
 	}
 
-	void PrintPolicy(LogPolicy, std::string&&) const;
+private:
+	//Keeps the head of str and ends it with "…[+N]", N = bytes cut off
+	void PutTruncated(std::string_view str, uint16_t length) noexcept {
+		char marker[32] = "\xE2\x80\xA6[+"; //U+2026
+		constexpr size_t kPrefix = 5;
+		//Sized for the most digits N can have, the real N is never longer
+		char* digits_end = std::to_chars(marker + kPrefix, marker + sizeof(marker) - 1, str.size()).ptr;
+		const size_t worst = size_t(digits_end - marker) + 1;
+		const size_t keep = length > worst ? length - worst : 0;
+		digits_end = std::to_chars(marker + kPrefix, marker + sizeof(marker) - 1, str.size() - keep).ptr;
+		*digits_end = ']';
+		const size_t marker_size = (std::min)(size_t(digits_end - marker) + 1, size_t(length) - keep);
 
+		const auto stored = static_cast<uint16_t>(keep + marker_size);
+		slack_ -= stored;
+		std::memcpy(cursor_, &stored, sizeof(stored));
+		std::memcpy(cursor_ + sizeof(stored), str.data(), keep);
+		std::memcpy(cursor_ + sizeof(stored) + keep, marker, marker_size);
+		cursor_ += sizeof(stored) + stored;
+	}
+
+private:
+	std::byte* cursor_;
+	size_t slack_;
+};
+
+class LogArgReader {
 public:
-	void LogLoop();
-	void Log(std::string&&);
-	void LogDetail(std::string_view, std::string_view, int, std::string&&);
+	explicit LogArgReader(const std::byte* cursor) noexcept :
+			cursor_(cursor) {}
+
+	template <typename T>
+	T Get() noexcept {
+		if constexpr (std::is_same_v<T, std::string_view>) {
+			uint16_t length;
+			std::memcpy(&length, cursor_, sizeof(length));
+			std::string_view str(reinterpret_cast<const char*>(cursor_ + sizeof(length)), length);
+			cursor_ += sizeof(length) + length;
+			return str;
+		} else {
+			T value;
+			std::memcpy(&value, cursor_, sizeof(T));
+			cursor_ += sizeof(T);
+			return value;
+		}
+	}
+
+private:
+	const std::byte* cursor_;
 };
 
-template <LogRank rk, typename... Args>
-inline void PrintLogFormat(std::format_string<Args...> fmt, Args&&... args) noexcept {
-	auto message = LogColor<rk> + std::format(fmt, std::forward<Args>(args)...);
-	AsyncLog::Instance().Log(std::move(message));
+template <typename... Stored>
+void FormatLogArgs(std::string& out, std::string_view format, const std::byte* args) {
+	LogArgReader reader(args);
+	//Braced init keeps the decode order left to right
+	std::tuple<Stored...> values{ reader.Get<Stored>()... };
+	std::apply([&](auto&... value) {
+		std::vformat_to(std::back_inserter(out), format, std::make_format_args(value...));
+	},
+			values);
 }
 
-template <LogRank rk, typename... Args>
-inline void PrintLogFormatDetail(const char* filename, int codeline, std::format_string<Args...> fmt, Args&&... args) noexcept {
-	auto message = std::format(fmt, std::forward<Args>(args)...);
-	AsyncLog::Instance().LogDetail(LogColor<rk>, filename, codeline, std::move(message));
-	if constexpr (rk == LogRank::kError) {
+} //namespace Detail
+
+/**
+ * @brief Deferred log call
+ * The caller only copies the argument bytes into its ring; the format string, file
+ * and line stay in the static LogSite. The caller stamps the record with a raw tick
+ * count; formatting and the conversion to time happen on the log thread.
+ */
+template <LogRank rk, LogPolicy po, typename... Args>
+inline void WriteLogRecord(const LogSite* site, std::format_string<Args...>, Args&&... args) noexcept {
+	static_assert(((Detail::LogStringArg<std::remove_cvref_t<Args>> || Detail::LogValueArg<std::remove_cvref_t<Args>>) && ...),
+			"Log arguments must be strings or trivially copyable, format others at the call site");
+	constexpr size_t kFixedBytes = (size_t(0) + ... + Detail::kLogFixedBytes<Detail::LogStored<Args>>);
+	static_assert(kFixedBytes <= LogRecord::kArgCapacity, "Too many log arguments for one record");
+
+	auto& log = AsyncLog::Instance();
+	LogRecord* record = log.Reserve();
+	if (record == nullptr) {
+		return;
+	}
+	record->site_ = site;
+	record->format_ = &Detail::FormatLogArgs<Detail::LogStored<Args>...>;
+	Detail::LogArgWriter writer(record->args_, LogRecord::kArgCapacity - kFixedBytes);
+	(writer.Put(static_cast<const std::remove_cvref_t<Args>&>(args)), ...);
+	record->ticks_ = Time::CoarseClock::Ticks();
+	log.Commit();
+
+	if constexpr (rk == LogRank::kError && po == LogPolicy::kDetail) {
 		assert(false);
 	}
 }
 
 }; //namespace Core::Log
 
-#define SGLOG_LEVEL_TRACE 0
-#define SGLOG_LEVEL_DEBUG 1
-#define SGLOG_LEVEL_INFO 2
-#define SGLOG_LEVEL_WARN 3
-#define SGLOG_LEVEL_ERROR 4
-
-#if !defined(LOG_ACTIVE_LEVEL)
-	#define LOG_ACTIVE_LEVEL SGLOG_LEVEL_INFO
-#endif
-
 // Defualt Async Log
 
-#if LOG_ACTIVE_LEVEL <= SGLOG_LEVEL_INFO
-	#define LogInfo(...)                                      \
-		Core::Log::PrintLogFormat<Core::Log::LogRank::kInfo>( \
-				__VA_ARGS__)
-	#define LogInfoDetail(...)                                      \
-		Core::Log::PrintLogFormatDetail<Core::Log::LogRank::kInfo>( \
-				__FILE__, __LINE__, __VA_ARGS__)
-#else
-	#define LogInfo(...) void(0);
-	#define LogInfoDetail(...) void(0);
-#endif
+#define SG_LOG_EXPAND(x) x
+#define SG_LOG_FIRST(first, ...) first
+#define SG_LOG_FORMAT(...) SG_LOG_EXPAND(SG_LOG_FIRST(__VA_ARGS__, ))
 
+#define SG_LOG_WRITE_IF(rk, po, category, condition, ...)                                              \
+	do {                                                                                               \
+		if constexpr (Core::Log::kRankCompiled<rk>) {                                                  \
+			static constexpr Core::Log::LogSite sg_log_site{ SG_LOG_FORMAT(__VA_ARGS__), __FILE__,     \
+				__LINE__, rk, po, category };                                                          \
+			if (Core::Log::LogFilter::Enabled(category, rk) && (condition)) {                          \
+				Core::Log::WriteLogRecord<rk, po>(&sg_log_site, __VA_ARGS__);                          \
+			}                                                                                          \
+		}                                                                                              \
+	} while (0)
 
-#if LOG_ACTIVE_LEVEL <= SGLOG_LEVEL_WARN
-	#define LogWarring(...)                                      \
-		Core::Log::PrintLogFormat<Core::Log::LogRank::kWarring>( \
-				__VA_ARGS__)
-	#define LogWarringDetail(...)                                      \
-		Core::Log::PrintLogFormatDetail<Core::Log::LogRank::kWarring>( \
-				__FILE__, __LINE__, __VA_ARGS__)
-#else
-	#define LogWarring(...) void(0);
-	#define LogWarringDetail(...) void(0);
-#endif
+#define SG_LOG_WRITE(rk, po, category, ...) \
+	SG_LOG_WRITE_IF(rk, po, category, true, __VA_ARGS__)
 
+#define SG_LOG_WRITE_LIMIT(rk, category, per_second, ...)                                         \
+	do {                                                                                          \
+		if constexpr (Core::Log::kRankCompiled<rk>) {                                             \
+			static Core::Log::LogRateLimit sg_log_limit;                                          \
+			SG_LOG_WRITE_IF(rk, Core::Log::LogPolicy::kSimple, category,                          \
+					sg_log_limit.Acquire(per_second), __VA_ARGS__);                               \
+		}                                                                                         \
+	} while (0)
 
-#if LOG_ACTIVE_LEVEL <= SGLOG_LEVEL_ERROR
-	#define LogError(...)                                      \
-		Core::Log::PrintLogFormat<Core::Log::LogRank::kError>( \
-				__VA_ARGS__)
-	#define LogErrorDetail(...)                                      \
-		Core::Log::PrintLogFormatDetail<Core::Log::LogRank::kError>( \
-				__FILE__, __LINE__, __VA_ARGS__)
-#else
-	#define LogError(...) void(0);
-	#define LogErrorDetail(...) void(0);
-#endif
+#define LogInfo(...) SG_LOG_WRITE(Core::Log::LogRank::kInfo, Core::Log::LogPolicy::kSimple, Core::Log::LogCategory::kGeneral, __VA_ARGS__)
+#define LogInfoDetail(...) SG_LOG_WRITE(Core::Log::LogRank::kInfo, Core::Log::LogPolicy::kDetail, Core::Log::LogCategory::kGeneral, __VA_ARGS__)
+#define LogWarring(...) SG_LOG_WRITE(Core::Log::LogRank::kWarring, Core::Log::LogPolicy::kSimple, Core::Log::LogCategory::kGeneral, __VA_ARGS__)
+#define LogWarringDetail(...) SG_LOG_WRITE(Core::Log::LogRank::kWarring, Core::Log::LogPolicy::kDetail, Core::Log::LogCategory::kGeneral, __VA_ARGS__)
+#define LogError(...) SG_LOG_WRITE(Core::Log::LogRank::kError, Core::Log::LogPolicy::kSimple, Core::Log::LogCategory::kGeneral, __VA_ARGS__)
+#define LogErrorDetail(...) SG_LOG_WRITE(Core::Log::LogRank::kError, Core::Log::LogPolicy::kDetail, Core::Log::LogCategory::kGeneral, __VA_ARGS__)
+
+// Category: LogInfoTo(Core::Log::LogCategory::kInput, "...")
+#define LogInfoTo(category, ...) SG_LOG_WRITE(Core::Log::LogRank::kInfo, Core::Log::LogPolicy::kSimple, category, __VA_ARGS__)
+#define LogWarringTo(category, ...) SG_LOG_WRITE(Core::Log::LogRank::kWarring, Core::Log::LogPolicy::kSimple, category, __VA_ARGS__)
+#define LogErrorTo(category, ...) SG_LOG_WRITE(Core::Log::LogRank::kError, Core::Log::LogPolicy::kSimple, category, __VA_ARGS__)
 
+// Rate limited: at most per_second records from this call site
+#define LogInfoLimit(category, per_second, ...) SG_LOG_WRITE_LIMIT(Core::Log::LogRank::kInfo, category, per_second, __VA_ARGS__)
+#define LogWarringLimit(category, per_second, ...) SG_LOG_WRITE_LIMIT(Core::Log::LogRank::kWarring, category, per_second, __VA_ARGS__)
+#define LogErrorLimit(category, per_second, ...) SG_LOG_WRITE_LIMIT(Core::Log::LogRank::kError, category, per_second, __VA_ARGS__)
 
 #endif
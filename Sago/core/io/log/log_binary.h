@@ -0,0 +1,57 @@
+#ifndef SG_LOG_BINARY_H
+#define SG_LOG_BINARY_H
+
+#include <cstdint>
+
+//On-disk layout of MappedFileSink, shared with tools/log_decoder
+namespace Core::Log::Binary {
+
+inline constexpr uint32_t kMagic = 0x424C4753; //"SGLB"
+inline constexpr uint16_t kVersion = 1;
+
+//wall time of a record = wall_base_ns_ + (timestamp - monotonic_base_ns_)
+struct FileHeader {
+	uint32_t magic_;
+	uint16_t version_;
+	uint16_t header_size_;
+	int64_t monotonic_base_ns_;
+	int64_t wall_base_ns_;
+	uint32_t sequence_; //rotation index
+	uint32_t reserved_;
+};
+
+//Files are preallocated and zero-filled, kEnd marks the end of written data
+enum class RecordType : uint8_t {
+	kEnd = 0,
+	kSite = 1,
+	kEntry = 2
+};
+
+//Emitted the first time a call site writes into a file, followed by file and format bytes
+struct SiteRecord {
+	RecordType type_;
+	uint8_t rank_;
+	uint8_t policy_;
+	uint8_t category_;
+	uint32_t id_;
+	uint32_t line_;
+	uint16_t file_length_;
+	uint16_t format_length_;
+};
+
+//Followed by length_ bytes of formatted message text
+struct EntryRecord {
+	RecordType type_;
+	uint8_t reserved_;
+	uint16_t length_;
+	uint32_t site_;
+	int64_t timestamp_ns_; //steady clock
+};
+
+static_assert(sizeof(FileHeader) == 32);
+static_assert(sizeof(SiteRecord) == 16);
+static_assert(sizeof(EntryRecord) == 16);
+
+} //namespace Core::Log::Binary
+
+#endif
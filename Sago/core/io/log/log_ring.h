@@ -0,0 +1,92 @@
+#ifndef SG_LOG_RING_H
+#define SG_LOG_RING_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Core::Log {
+
+enum class LogRank;
+enum class LogPolicy : short;
+enum class LogCategory : uint8_t;
+
+//Static per call site, never copied into the ring
+struct LogSite {
+	std::string_view format_;
+	const char* file_;
+	uint32_t line_;
+	LogRank rank_;
+	LogPolicy policy_;
+	LogCategory category_;
+};
+
+//Decodes args_ and formats it with the site's format string, runs on the log thread
+using LogFormatFn = void (*)(std::string& out, std::string_view format, const std::byte* args);
+
+//Fixed-size record, filled in place by the calling thread
+struct alignas(64) LogRecord {
+	static constexpr size_t kArgCapacity = 256 - 24;
+
+	const LogSite* site_;
+	LogFormatFn format_;
+	uint64_t ticks_; //CoarseClock::Ticks() at commit
+	std::byte args_[kArgCapacity];
+};
+
+static_assert(sizeof(LogRecord) == 256, "LogRecord should stay four cache lines");
+
+/**
+ * @brief SPSC ring owned by one logging thread, drained by the log thread
+ * Reserve/Commit never allocate; the record is written in place.
+ */
+class ThreadLogRing {
+public:
+	static constexpr size_t kCapacity = 512;
+	static_assert((kCapacity & (kCapacity - 1)) == 0, "kCapacity must be power of 2");
+
+	//Producer: nullptr when full
+	LogRecord* Reserve() noexcept {
+		const size_t tail = tail_.load(std::memory_order_relaxed);
+		if (tail - head_.load(std::memory_order_acquire) == kCapacity) {
+			return nullptr;
+		}
+		return &records_[tail & (kCapacity - 1)];
+	}
+
+	void Commit() noexcept {
+		tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	//Consumer
+	template <typename F>
+	size_t Drain(F&& fn) {
+		size_t head = head_.load(std::memory_order_relaxed);
+		const size_t tail = tail_.load(std::memory_order_acquire);
+		const size_t count = tail - head;
+		for (; head != tail; ++head) {
+			fn(records_[head & (kCapacity - 1)]);
+		}
+		head_.store(tail, std::memory_order_release);
+		return count;
+	}
+
+	bool Empty() const noexcept {
+		return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+	}
+
+	//Set when the owning thread exits, the log thread frees it once empty
+	std::atomic<bool> retired_{ false };
+
+private:
+	std::array<LogRecord, kCapacity> records_;
+	alignas(64) std::atomic<size_t> head_{ 0 };
+	alignas(64) std::atomic<size_t> tail_{ 0 };
+};
+
+} //namespace Core::Log
+
+#endif
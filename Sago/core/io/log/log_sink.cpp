@@ -0,0 +1,247 @@
+#include "log_sink.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <utility>
+
+#include "log_binary.h"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Core::Log {
+
+namespace {
+
+std::string_view FileName(const char* path) noexcept {
+	if (path == nullptr) {
+		return {};
+	}
+	std::string_view file(path);
+	const auto pos = file.find_last_of("/\\");
+	return pos == std::string_view::npos ? file : file.substr(pos + 1);
+}
+
+const char* RankColor(LogRank rank) noexcept {
+	switch (rank) {
+		case LogRank::kInfo:
+			return LogColor<LogRank::kInfo>;
+		case LogRank::kWarring:
+			return LogColor<LogRank::kWarring>;
+		case LogRank::kError:
+			return LogColor<LogRank::kError>;
+		default:
+			return LogColor<LogRank::kVulkanLayer>;
+	}
+}
+
+//A sink can't log through AsyncLog from the log thread, its own failures go to stderr
+void ReportOpenFailure(const std::string& path, const char* step) noexcept {
+#if defined(_WIN32)
+	std::fprintf(stderr, "[Log][MappedFileSink] %s failed for %s (error %lu), file logging stopped\n",
+			step, path.c_str(), static_cast<unsigned long>(GetLastError()));
+#else
+	std::fprintf(stderr, "[Log][MappedFileSink] %s failed for %s (%s), file logging stopped\n",
+			step, path.c_str(), std::strerror(errno));
+#endif
+}
+
+size_t SiteBytes(const LogSite& site) noexcept {
+	return sizeof(Binary::SiteRecord) + FileName(site.file_).size() + site.format_.size();
+}
+
+} //namespace
+
+//ConsoleSink
+
+ConsoleSink::ConsoleSink() {
+	batch_.reserve(64 * 1024);
+}
+
+void ConsoleSink::Write(const LogEntry& entry) {
+	const LogSite& site = *entry.site_;
+	batch_ += RankColor(site.rank_);
+	if (site.policy_ == LogPolicy::kDetail) {
+		std::format_to(std::back_inserter(batch_), "[{}:{}] ", FileName(site.file_), site.line_);
+	}
+	batch_ += entry.text_;
+	if (site.policy_ == LogPolicy::kDetail) {
+		batch_ += "---------------->";
+		batch_ += entry.wall_text_;
+	}
+	batch_ += Color::RESET;
+	batch_ += '\n';
+}
+
+void ConsoleSink::Flush() {
+	if (batch_.empty()) {
+		return;
+	}
+	std::fwrite(batch_.data(), 1, batch_.size(), stdout);
+	std::fflush(stdout);
+	batch_.clear();
+}
+
+//MappedFileSink
+
+MappedFileSink::MappedFileSink(std::string base_path, size_t file_bytes, uint32_t max_files) :
+		base_path_(std::move(base_path)),
+		file_bytes_((std::max)(file_bytes, size_t(64) * 1024)),
+		max_files_((std::max)(max_files, 1u)) {
+	Open(0);
+}
+
+MappedFileSink::~MappedFileSink() {
+	Close();
+}
+
+bool MappedFileSink::Open(uint32_t sequence) {
+	sequence_ = sequence;
+	site_ids_.clear();
+	const std::string path = std::format("{}.{}.sglog", base_path_, sequence % max_files_);
+
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+			CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		ReportOpenFailure(path, "open");
+		return false;
+	}
+	const auto size = static_cast<uint64_t>(file_bytes_);
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+			static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+	void* data = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, file_bytes_) : nullptr;
+	if (data == nullptr) {
+		ReportOpenFailure(path, "map");
+		if (mapping != nullptr) {
+			CloseHandle(mapping);
+		}
+		CloseHandle(file);
+		return false;
+	}
+	file_ = file;
+	mapping_ = mapping;
+#else
+	const int file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (file < 0) {
+		ReportOpenFailure(path, "open");
+		return false;
+	}
+	//Preallocate so writes never extend the file
+	if (::ftruncate(file, static_cast<off_t>(file_bytes_)) != 0) {
+		ReportOpenFailure(path, "preallocate");
+		::close(file);
+		return false;
+	}
+	void* data = ::mmap(nullptr, file_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+	if (data == MAP_FAILED) {
+		ReportOpenFailure(path, "mmap");
+		::close(file);
+		return false;
+	}
+	file_ = file;
+#endif
+	data_ = static_cast<std::byte*>(data);
+
+	using namespace std::chrono;
+	Binary::FileHeader header{};
+	header.magic_ = Binary::kMagic;
+	header.version_ = Binary::kVersion;
+	header.header_size_ = sizeof(Binary::FileHeader);
+	header.monotonic_base_ns_ = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+	header.wall_base_ns_ = duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+	header.sequence_ = sequence;
+	std::memcpy(data_, &header, sizeof(header));
+	offset_ = sizeof(header);
+	return true;
+}
+
+void MappedFileSink::Close() noexcept {
+	if (data_ == nullptr) {
+		return;
+	}
+	//Trim the unused preallocation
+#if defined(_WIN32)
+	UnmapViewOfFile(data_);
+	CloseHandle(static_cast<HANDLE>(mapping_));
+	LARGE_INTEGER size;
+	size.QuadPart = static_cast<LONGLONG>(offset_);
+	SetFilePointerEx(static_cast<HANDLE>(file_), size, nullptr, FILE_BEGIN);
+	SetEndOfFile(static_cast<HANDLE>(file_));
+	CloseHandle(static_cast<HANDLE>(file_));
+	file_ = mapping_ = nullptr;
+#else
+	::munmap(data_, file_bytes_);
+	[[maybe_unused]] const int result = ::ftruncate(file_, static_cast<off_t>(offset_));
+	::close(file_);
+	file_ = -1;
+#endif
+	data_ = nullptr;
+	offset_ = 0;
+}
+
+uint32_t MappedFileSink::SiteId(const LogSite* site) {
+	if (auto it = site_ids_.find(site); it != site_ids_.end()) {
+		return it->second;
+	}
+	const auto file = FileName(site->file_);
+	Binary::SiteRecord record{};
+	record.type_ = Binary::RecordType::kSite;
+	record.rank_ = static_cast<uint8_t>(site->rank_);
+	record.policy_ = static_cast<uint8_t>(site->policy_);
+	record.category_ = static_cast<uint8_t>(site->category_);
+	record.id_ = static_cast<uint32_t>(site_ids_.size());
+	record.line_ = site->line_;
+	record.file_length_ = static_cast<uint16_t>(file.size());
+	record.format_length_ = static_cast<uint16_t>(site->format_.size());
+
+	std::byte* cursor = data_ + offset_;
+	std::memcpy(cursor, &record, sizeof(record));
+	std::memcpy(cursor + sizeof(record), file.data(), file.size());
+	std::memcpy(cursor + sizeof(record) + file.size(), site->format_.data(), site->format_.size());
+	offset_ += SiteBytes(*site);
+
+	site_ids_.emplace(site, record.id_);
+	return record.id_;
+}
+
+void MappedFileSink::Write(const LogEntry& entry) {
+	const size_t length = (std::min)(entry.text_.size(), size_t(UINT16_MAX));
+	const size_t entry_bytes = sizeof(Binary::EntryRecord) + length;
+	const auto fits = [&] {
+		const size_t site_bytes = site_ids_.contains(entry.site_) ? 0 : SiteBytes(*entry.site_);
+		return offset_ + entry_bytes + site_bytes <= file_bytes_;
+	};
+
+	if (data_ != nullptr && !fits()) {
+		Close();
+		Open(sequence_ + 1);
+	}
+	//Sites are re-emitted after a rotation
+	if (data_ == nullptr || !fits()) {
+		return;
+	}
+
+	Binary::EntryRecord record{};
+	record.type_ = Binary::RecordType::kEntry;
+	record.length_ = static_cast<uint16_t>(length);
+	record.site_ = SiteId(entry.site_);
+	record.timestamp_ns_ = entry.timestamp_ns_;
+
+	std::byte* cursor = data_ + offset_;
+	std::memcpy(cursor, &record, sizeof(record));
+	std::memcpy(cursor + sizeof(record), entry.text_.data(), length);
+	offset_ += entry_bytes;
+}
+
+} //namespace Core::Log
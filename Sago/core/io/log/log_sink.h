@@ -0,0 +1,91 @@
+#ifndef SG_LOG_SINK_H
+#define SG_LOG_SINK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "core/util/dll_export.h"
+#include "log.h"
+
+namespace Core::Log {
+
+//One formatted message, valid only for the duration of LogSink::Write
+struct LogEntry {
+	const LogSite* site_;
+	int64_t timestamp_ns_; //steady clock, stamped when the record was committed
+	std::string_view wall_text_; //"[%Y-%m-%d %H:%M:%S]", cached per second
+	std::string_view text_;
+};
+
+/**
+ * @brief Log output
+ * Write and Flush are only called from the log thread, once per record and once
+ * per batch; a sink needs no locking of its own.
+ */
+class SAGA_API LogSink {
+public:
+	virtual ~LogSink() = default;
+	virtual void Write(const LogEntry& entry) = 0;
+	virtual void Flush() {}
+};
+
+//ANSI-colored text on stdout, one fwrite per batch
+class SAGA_API ConsoleSink : public LogSink {
+public:
+	ConsoleSink();
+	void Write(const LogEntry& entry) override;
+	void Flush() override;
+
+private:
+	std::string batch_;
+};
+
+/**
+ * @brief Binary log in memory-mapped, preallocated files
+ * Records are memcpy'd into the mapping, no syscall per line. When a file is full
+ * the sink moves on to the next of max_files files (base.0.sglog, base.1.sglog ...),
+ * overwriting the oldest. Decode with tools/log_decoder.
+ */
+class SAGA_API MappedFileSink : public LogSink {
+public:
+	static constexpr size_t kDefaultFileBytes = size_t(32) << 20;
+
+	explicit MappedFileSink(std::string base_path, size_t file_bytes = kDefaultFileBytes, uint32_t max_files = 4);
+	~MappedFileSink() override;
+
+	MappedFileSink(const MappedFileSink&) = delete;
+	MappedFileSink& operator=(const MappedFileSink&) = delete;
+
+	void Write(const LogEntry& entry) override;
+
+	bool IsOpen() const noexcept { return data_ != nullptr; }
+
+private:
+	bool Open(uint32_t sequence);
+	void Close() noexcept;
+	uint32_t SiteId(const LogSite* site);
+
+	std::string base_path_;
+	size_t file_bytes_;
+	uint32_t max_files_;
+	uint32_t sequence_ = 0;
+
+	std::byte* data_ = nullptr;
+	size_t offset_ = 0;
+#if defined(_WIN32)
+	void* file_ = nullptr;
+	void* mapping_ = nullptr;
+#else
+	int file_ = -1;
+#endif
+
+	//Ids are per file, every file is decodable on its own
+	std::unordered_map<const LogSite*, uint32_t> site_ids_;
+};
+
+} //namespace Core::Log
+
+#endif
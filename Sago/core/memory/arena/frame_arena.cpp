@@ -0,0 +1,86 @@
+#include "frame_arena.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace Core::Memory {
+
+LinearArena::~LinearArena() {
+	ReleaseOverflow();
+	::operator delete(buffer_, std::align_val_t(alignof(std::max_align_t)));
+}
+
+void LinearArena::Reserve(size_t capacity) {
+	if (capacity <= capacity_) {
+		return;
+	}
+	//Allocate first, a bad_alloc leaves the old buffer in place
+	auto* buffer = static_cast<std::byte*>(::operator new(capacity, std::align_val_t(alignof(std::max_align_t))));
+	::operator delete(buffer_, std::align_val_t(alignof(std::max_align_t)));
+	buffer_ = buffer;
+	capacity_ = capacity;
+	offset_ = 0;
+	++heap_allocations_;
+}
+
+void* LinearArena::AllocateOverflow(size_t bytes, size_t alignment) {
+	//Header keeps the chain, payload follows at the requested alignment
+	alignment = std::max(alignment, alignof(Overflow));
+	size_t header = (sizeof(Overflow) + alignment - 1) & ~(alignment - 1);
+	auto* raw = static_cast<std::byte*>(::operator new(header + bytes, std::align_val_t(alignment)));
+	auto* node = reinterpret_cast<Overflow*>(raw);
+	node->next = overflow_;
+	node->alignment = alignment;
+	overflow_ = node;
+	overflow_bytes_ += bytes + alignment;
+	++heap_allocations_;
+	return raw + header;
+}
+
+void LinearArena::ReleaseOverflow() noexcept {
+	while (overflow_ != nullptr) {
+		Overflow* next = overflow_->next;
+		::operator delete(overflow_, std::align_val_t(overflow_->alignment));
+		overflow_ = next;
+	}
+}
+
+void LinearArena::Reset() noexcept {
+	high_water_ = std::max(high_water_, Used());
+	if (overflow_ != nullptr) [[unlikely]] {
+		ReleaseOverflow();
+		size_t grown = std::bit_ceil(capacity_ + overflow_bytes_);
+		overflow_bytes_ = 0;
+		try {
+			Reserve(grown);
+		} catch (const std::bad_alloc&) {
+			//keep the old buffer, next frame overflows again
+		}
+	}
+	offset_ = 0;
+}
+
+FrameArena::FrameArena(uint32_t frames, size_t capacity) :
+		frames_(std::clamp<uint32_t>(frames, 1, kMaxFramesInFlight)) {
+	for (uint32_t i = 0; i < frames_; ++i) {
+		arenas_[i].Reserve(capacity);
+		resources_[i].Bind(&arenas_[i]);
+	}
+}
+
+void FrameArena::BeginFrame(uint32_t frame_index) noexcept {
+	current_ = frame_index % frames_;
+	arenas_[current_].Reset();
+}
+
+LinearArena& FrameArena::ThreadLocal() {
+	thread_local LinearArena arena{ LinearArena::kDefaultCapacity / 4 };
+	return arena;
+}
+
+std::pmr::memory_resource* FrameArena::ThreadLocalResource() {
+	thread_local ArenaResource resource{ &ThreadLocal() };
+	return &resource;
+}
+
+} //namespace Core::Memory
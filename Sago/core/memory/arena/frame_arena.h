@@ -0,0 +1,130 @@
+#ifndef SG_MEMORY_FRAME_ARENA_H
+#define SG_MEMORY_FRAME_ARENA_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+namespace Core::Memory {
+
+/**
+ * @brief Bump allocator, Reset() is O(1)
+ * When a frame outgrows the buffer the extra bytes come from the heap; the next
+ * Reset() grows the buffer once so the steady state does no heap allocation.
+ */
+class LinearArena {
+public:
+	static constexpr size_t kDefaultCapacity = 256 * 1024;
+
+	LinearArena() = default;
+	explicit LinearArena(size_t capacity) { Reserve(capacity); }
+	~LinearArena();
+
+	LinearArena(const LinearArena&) = delete;
+	LinearArena& operator=(const LinearArena&) = delete;
+
+	void Reserve(size_t capacity);
+
+	void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+		//Align the address, the buffer itself is only max_align_t aligned
+		const auto base = reinterpret_cast<uintptr_t>(buffer_);
+		size_t offset = ((base + offset_ + alignment - 1) & ~(alignment - 1)) - base;
+		if (offset + bytes <= capacity_) [[likely]] {
+			offset_ = offset + bytes;
+			return buffer_ + offset;
+		}
+		return AllocateOverflow(bytes, alignment);
+	}
+
+	template <typename T>
+	T* Allocate(size_t count = 1) {
+		return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+	}
+
+	void Reset() noexcept;
+
+	size_t Used() const noexcept { return offset_ + overflow_bytes_; }
+	size_t Capacity() const noexcept { return capacity_; }
+	size_t HighWater() const noexcept { return high_water_; }
+	//Heap allocations made by this arena since construction (buffer growth + overflow)
+	size_t HeapAllocations() const noexcept { return heap_allocations_; }
+
+private:
+	void* AllocateOverflow(size_t bytes, size_t alignment);
+	void ReleaseOverflow() noexcept;
+
+private:
+	struct Overflow {
+		Overflow* next;
+		size_t alignment;
+	};
+
+	std::byte* buffer_ = nullptr;
+	size_t capacity_ = 0;
+	size_t offset_ = 0;
+
+	Overflow* overflow_ = nullptr;
+	size_t overflow_bytes_ = 0;
+	size_t high_water_ = 0;
+	size_t heap_allocations_ = 0;
+};
+
+// std::pmr adapter, deallocate is a no-op until the arena resets
+class ArenaResource : public std::pmr::memory_resource {
+public:
+	explicit ArenaResource(LinearArena* arena = nullptr) :
+			arena_(arena) {}
+	void Bind(LinearArena* arena) noexcept { arena_ = arena; }
+
+private:
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		return arena_->Allocate(bytes, alignment);
+	}
+	void do_deallocate(void*, size_t, size_t) override {}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+
+private:
+	LinearArena* arena_;
+};
+
+/**
+ * @brief Per-frame arenas keyed by the frame-in-flight index
+ * BeginFrame(i) must only be called once the GPU fence for frame i has signaled,
+ * so memory handed out while recording frame i stays valid until then.
+ */
+class FrameArena {
+public:
+	static constexpr uint32_t kMaxFramesInFlight = 3;
+
+	explicit FrameArena(uint32_t frames = 2, size_t capacity = LinearArena::kDefaultCapacity);
+
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+
+	void BeginFrame(uint32_t frame_index) noexcept;
+
+	LinearArena& Current() noexcept { return arenas_[current_]; }
+	std::pmr::memory_resource* Resource() noexcept { return &resources_[current_]; }
+	uint32_t FrameCount() const noexcept { return frames_; }
+
+	template <typename T>
+	T* Allocate(size_t count = 1) { return Current().Allocate<T>(count); }
+
+	//Worker / main thread scratch, the owning thread resets it at its own frame boundary
+	static LinearArena& ThreadLocal();
+	static std::pmr::memory_resource* ThreadLocalResource();
+
+private:
+	std::array<LinearArena, kMaxFramesInFlight> arenas_;
+	std::array<ArenaResource, kMaxFramesInFlight> resources_;
+	uint32_t frames_;
+	uint32_t current_ = 0;
+};
+
+} //namespace Core::Memory
+
+#endif
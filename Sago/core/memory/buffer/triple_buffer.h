@@ -0,0 +1,78 @@
+#ifndef SG_MEMORY_TRIPLE_BUFFER_H
+#define SG_MEMORY_TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace Core::Memory {
+
+/**
+ * @brief Wait-free single producer / single consumer state handoff
+ * Three slots: the writer owns back, the reader owns front, and middle holds the
+ * latest published one. Publish and Fetch are a single exchange on middle, so the
+ * writer never blocks and the reader always sees the newest complete snapshot.
+ * The writer's slot after Publish holds an older snapshot: write the whole state.
+ */
+template <typename T>
+class LockFreeTripleBuffer {
+	static constexpr uint8_t kIndexMask = 0b011;
+	static constexpr uint8_t kDirtyBit = 0b100;
+
+	struct alignas(64) Slot {
+		T value_{};
+	};
+
+public:
+	LockFreeTripleBuffer() = default;
+	explicit LockFreeTripleBuffer(const T& initial) {
+		for (auto& slot : slots_) {
+			slot.value_ = initial;
+		}
+	}
+	LockFreeTripleBuffer(const LockFreeTripleBuffer&) = delete;
+	LockFreeTripleBuffer& operator=(const LockFreeTripleBuffer&) = delete;
+
+	//Writer
+	T& Write() noexcept { return slots_[back_].value_; }
+
+	void Publish() noexcept {
+		const uint8_t prev = middle_.exchange(back_ | kDirtyBit, std::memory_order_acq_rel);
+		back_ = prev & kIndexMask;
+	}
+
+	template <typename F>
+	void update(F&& writer) {
+		std::forward<F>(writer)(Write());
+		Publish();
+	}
+
+	//Reader: true when a newer snapshot was swapped in
+	bool Fetch() noexcept {
+		if ((middle_.load(std::memory_order_relaxed) & kDirtyBit) == 0) {
+			return false;
+		}
+		const uint8_t prev = middle_.exchange(front_, std::memory_order_acq_rel);
+		front_ = prev & kIndexMask;
+		return true;
+	}
+
+	const T& Read() const noexcept { return slots_[front_].value_; }
+
+	template <typename F>
+	bool read(F&& reader) {
+		const bool fresh = Fetch();
+		std::forward<F>(reader)(Read());
+		return fresh;
+	}
+
+private:
+	Slot slots_[3];
+	alignas(64) std::atomic<uint8_t> middle_{ 1 };
+	alignas(64) uint8_t back_ = 0; //writer only
+	alignas(64) uint8_t front_ = 2; //reader only
+};
+
+} //namespace Core::Memory
+
+#endif
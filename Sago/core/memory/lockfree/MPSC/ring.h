@@ -0,0 +1,95 @@
+#ifndef SG_MEMORY_LOCKFREE_MPSC_RING_H
+#define SG_MEMORY_LOCKFREE_MPSC_RING_H
+//MPSC
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace Core::Memory {
+
+/**
+ * @brief Bounded multi-producer / single-consumer ring
+ * Every slot carries a sequence number. A producer claims a slot by CAS on tail and
+ * marks it ready (seq = pos + 1) only after the value is written, so the consumer
+ * stops at the first slot that is claimed but not yet filled and never reads torn data.
+ */
+template <typename T, size_t Capacity = 1024>
+class LockFreeMpscRing {
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
+	static constexpr size_t kMask = Capacity - 1;
+
+	struct Slot {
+		std::atomic<size_t> seq_;
+		T value_;
+	};
+
+public:
+	LockFreeMpscRing() {
+		for (size_t i = 0; i < Capacity; ++i) {
+			slots_[i].seq_.store(i, std::memory_order_relaxed);
+		}
+	}
+	LockFreeMpscRing(const LockFreeMpscRing&) = delete;
+	LockFreeMpscRing& operator=(const LockFreeMpscRing&) = delete;
+
+	//Any thread
+	template <typename U>
+	bool push(U&& item) {
+		size_t pos = tail_.load(std::memory_order_relaxed);
+		for (;;) {
+			Slot& slot = slots_[pos & kMask];
+			const size_t seq = slot.seq_.load(std::memory_order_acquire);
+			const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+			if (diff == 0) {
+				if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					slot.value_ = std::forward<U>(item);
+					slot.seq_.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+			} else if (diff < 0) {
+				return false; // fill
+			} else {
+				pos = tail_.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	//Consumer only: hands each ready item to fn, returns how many were taken
+	template <typename F>
+	size_t consume(F&& fn, size_t max_items = Capacity) {
+		size_t head = head_.load(std::memory_order_relaxed);
+		size_t count = 0;
+		while (count < max_items) {
+			Slot& slot = slots_[head & kMask];
+			if (slot.seq_.load(std::memory_order_acquire) != head + 1) {
+				break; //empty or still being written
+			}
+			fn(slot.value_);
+			slot.seq_.store(head + Capacity, std::memory_order_release);
+			++head;
+			++count;
+		}
+		head_.store(head, std::memory_order_release);
+		return count;
+	}
+
+	//Approximate while producers are active
+	size_t size() const noexcept {
+		const size_t head = head_.load(std::memory_order_acquire);
+		const size_t tail = tail_.load(std::memory_order_acquire);
+		return tail > head ? tail - head : 0;
+	}
+
+	bool empty() const noexcept { return size() == 0; }
+	static constexpr size_t capacity() noexcept { return Capacity; }
+
+private:
+	std::array<Slot, Capacity> slots_;
+	alignas(64) std::atomic<size_t> tail_{ 0 };
+	alignas(64) std::atomic<size_t> head_{ 0 };
+};
+
+} //namespace Core::Memory
+
+#endif
@@ -18,17 +18,17 @@ private:
 				next(nullptr) {}
 	};
 
+	ObjectPool<Node> pool_;
 	std::atomic<Node*> head;
 	std::atomic<Node*> tail;
-	ObjectPool<Node> pool_;
 
 public:
 	LockFreeQueue() :
-			head(new Node), tail(head.load()) {}
+			head(pool_.New()), tail(head.load()) {}
 	~LockFreeQueue() {
 		while (Node* const old_head = head.load()) {
 			head.store(old_head->next);
-			delete old_head;
+			pool_.Delete(old_head);
 		}
 	}
 
@@ -39,7 +39,7 @@ public:
 		}
 		std::shared_ptr<T> const res(old_head->data);
 		head.store(old_head->next, std::memory_order_release);
-		delete old_head;
+		pool_.Delete(old_head);
 		return res;
 	}
 
@@ -59,7 +59,7 @@ public:
 		}
 		std::shared_ptr<T> const res(old_head->data);
 		head.store(old_head->next, std::memory_order_release);
-		delete old_head;
+		pool_.Delete(old_head);
 		return res;
 	}
 };
@@ -74,13 +74,13 @@ private:
 				next(nullptr) {}
 	};
 
+	ObjectPool<Node> pool_;
 	std::atomic<Node*> head;
 	std::atomic<Node*> tail;
-	ObjectPool<Node> pool_;
 
 public:
 	LockFreeQueue_Pool() :
-			head(new Node), tail(head.load()) {}
+			head(pool_.New()), tail(head.load()) {}
 	~LockFreeQueue_Pool() {
 		// while (Node* const old_head = head.load()) {
 		// 	head.store(old_head->next);
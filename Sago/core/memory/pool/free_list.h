@@ -1,9 +1,18 @@
 #ifndef SG_MEMORY_FREELIST_H
 #define SG_MEMORY_FREELIST_H
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <new>
+#include <utility>
+#include <vector>
 
 #include "core/io/log/log.h"
+#include "core/memory/tracking/memory_tracker.h"
+#include "core/util/spain_lock.h"
 
 #if defined(_WIN32)
 #include <Windows.h>
@@ -35,61 +44,321 @@ inline static void* SystemAlloc(size_t kpage) {
 	return ptr;
 }
 
-template <class T, size_t N = 1024>
+enum class PagePolicy : uint8_t {
+	kDefault = 0,
+	kTransparentHuge = 1, //madvise(MADV_HUGEPAGE)
+	kHuge = 2 //MAP_HUGETLB, committed up front; falls back to kTransparentHuge
+};
+
+inline constexpr size_t kHugePageSize = size_t(2) << 20;
+
+//Virtual Reserve: pages are committed lazily on first touch
+struct SystemRegion {
+	void* ptr = nullptr;
+	size_t size = 0;
+	bool from_heap = false;
+};
+
+inline SystemRegion SystemReserve(size_t bytes, PagePolicy policy = PagePolicy::kDefault) {
+	SystemRegion region{ nullptr, bytes, false };
+#if defined(_WIN32)
+	//Address space only, SystemCommit backs it as slabs are handed out
+	region.ptr = VirtualAlloc(0, bytes, MEM_RESERVE, PAGE_READWRITE);
+#elif defined(__linux__)
+	void* ptr = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+	if (policy == PagePolicy::kHuge) {
+		//Reserved up front: with MAP_NORESERVE the map succeeds on an empty hugetlb
+		//pool and the first touch raises SIGBUS, this way it fails here and falls back
+		region.size = (bytes + kHugePageSize - 1) & ~(kHugePageSize - 1);
+		ptr = mmap(0, region.size, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	}
+#endif
+	if (ptr == MAP_FAILED) {
+		region.size = bytes;
+		ptr = mmap(0, region.size, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+#if defined(MADV_HUGEPAGE)
+		if (ptr != MAP_FAILED && policy != PagePolicy::kDefault) {
+			madvise(ptr, region.size, MADV_HUGEPAGE);
+		}
+#endif
+	}
+	region.ptr = (ptr == MAP_FAILED) ? nullptr : ptr;
+#endif
+	if (region.ptr == nullptr) {
+		region.ptr = ::operator new(bytes, std::nothrow);
+		region.size = bytes;
+		region.from_heap = true;
+	}
+	return region;
+}
+
+//Makes [ptr, ptr + bytes) of a reservation usable; Linux commits on first touch already
+inline bool SystemCommit(const SystemRegion& region, void* ptr, size_t bytes) noexcept {
+	if (region.from_heap) {
+		return true;
+	}
+#if defined(_WIN32)
+	return VirtualAlloc(ptr, bytes, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+	(void)ptr;
+	(void)bytes;
+	return true;
+#endif
+}
+
+inline void SystemRelease(const SystemRegion& region) noexcept {
+	if (region.ptr == nullptr) {
+		return;
+	}
+	if (region.from_heap) {
+		::operator delete(region.ptr);
+		return;
+	}
+#if defined(_WIN32)
+	VirtualFree(region.ptr, 0, MEM_RELEASE);
+#elif defined(__linux__)
+	munmap(region.ptr, region.size);
+#endif
+}
+
+namespace Detail {
+
+inline constexpr uint32_t kMaxThreadHeaps = 64;
+inline constexpr uint32_t kSharedHeap = kMaxThreadHeaps;
+
+//Thread Slot: small process-wide index, recycled when the thread exits
+class ThreadSlotRegistry {
+public:
+	static uint32_t Acquire() {
+		std::lock_guard lock(Mutex());
+		auto& used = Used();
+		for (uint32_t i = 0; i < kMaxThreadHeaps; ++i) {
+			if (!used[i]) {
+				used[i] = true;
+				return i;
+			}
+		}
+		return kSharedHeap;
+	}
+
+	static void Release(uint32_t slot) {
+		if (slot >= kMaxThreadHeaps) {
+			return;
+		}
+		std::lock_guard lock(Mutex());
+		Used()[slot] = false;
+	}
+
+private:
+	static std::mutex& Mutex() {
+		static std::mutex mutex;
+		return mutex;
+	}
+	static std::array<bool, kMaxThreadHeaps>& Used() {
+		static std::array<bool, kMaxThreadHeaps> used{};
+		return used;
+	}
+};
+
+struct ThreadSlot {
+	uint32_t index_ = ThreadSlotRegistry::Acquire();
+	~ThreadSlot() { ThreadSlotRegistry::Release(index_); }
+};
+
+inline uint32_t CurrentThreadSlot() noexcept {
+	thread_local ThreadSlot slot;
+	return slot.index_;
+}
+
+} //namespace Detail
+
+/**
+ * @brief Slab object pool
+ * Slabs are carved out of large virtual reservations and aligned to their own size,
+ * so Delete finds the owning slab with a mask. Every thread owns a heap with a plain
+ * free list; frees from other threads go to the owner's atomic remote list and are
+ * taken back in one exchange. Release drops whole reservations, not single objects.
+ * A heap is only created by the first New on its thread slot, an idle pool costs
+ * one pointer per slot. Committed slabs are counted against Tag.
+ */
+template <class T, size_t N = 1024, MemoryTag Tag = MemoryTag::kGeneral>
 class ObjectPool {
-	char* memory_ = nullptr;
-	size_t size_{};
-	void* free_list_{};
+	static_assert(N > 0, "ObjectPool slab must hold at least one object");
+
+	struct FreeNode {
+		FreeNode* next;
+	};
+
+	struct SlabHeader {
+		uint32_t owner_;
+	};
+
+	static constexpr size_t kAlign = alignof(T) > alignof(FreeNode) ? alignof(T) : alignof(FreeNode);
+	static constexpr size_t kStride = ((sizeof(T) > sizeof(FreeNode) ? sizeof(T) : sizeof(FreeNode)) + kAlign - 1) & ~(kAlign - 1);
+	static constexpr size_t kHeaderSize = (sizeof(SlabHeader) + kAlign - 1) & ~(kAlign - 1);
+	static constexpr size_t kSlabSize = std::bit_ceil(kHeaderSize + kStride * N) < 4096 ? 4096 : std::bit_ceil(kHeaderSize + kStride * N);
+	static constexpr size_t kSlabMask = ~(kSlabSize - 1);
+	static constexpr size_t kSlabsPerReserve = 64;
+
+	struct alignas(64) ThreadHeap {
+		FreeNode* local_free_ = nullptr;
+		char* bump_ = nullptr;
+		char* bump_end_ = nullptr;
+		alignas(64) std::atomic<FreeNode*> remote_free_{ nullptr };
+	};
+
+	//Reservation
+	std::vector<SystemRegion> regions_;
+	char* reserve_cursor_ = nullptr;
+	char* reserve_end_ = nullptr;
+	std::atomic<size_t> slab_count_{ 0 };
+	PagePolicy policy_;
+	util::SpinLock grow_lock_;
+	util::SpinLock shared_lock_;
+
+	//Written once per slot by its owner, read by threads freeing into it
+	std::array<std::atomic<ThreadHeap*>, Detail::kMaxThreadHeaps + 1> heaps_{};
 
 public:
+	explicit ObjectPool(PagePolicy policy = PagePolicy::kDefault) :
+			policy_(policy) {}
+	~ObjectPool() {
+		Release();
+		for (auto& heap : heaps_) {
+			delete heap.load(std::memory_order_relaxed);
+		}
+	}
+
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
 	void Delete(T* obj) {
+		if (obj == nullptr) [[unlikely]] {
+			return;
+		}
 		obj->~T();
 
-		*(void**)obj = free_list_; 
-		free_list_ = *(void**)obj; 
+		auto* node = reinterpret_cast<FreeNode*>(obj);
+		const uint32_t owner = SlabOf(obj)->owner_;
+		const uint32_t slot = Detail::CurrentThreadSlot();
+		//The owner's heap exists, it allocated the slab
+		ThreadHeap* heap = heaps_[owner].load(std::memory_order_acquire);
+		if (owner == slot && slot != Detail::kSharedHeap) [[likely]] {
+			node->next = heap->local_free_;
+			heap->local_free_ = node;
+			return;
+		}
+		//Cross Thread
+		auto& remote = heap->remote_free_;
+		node->next = remote.load(std::memory_order_relaxed);
+		while (!remote.compare_exchange_weak(node->next, node,
+				std::memory_order_release, std::memory_order_relaxed)) {
+		}
 	}
 
-	T* New() {
-		T* obj = nullptr;
-
-		if (free_list_) {
-			obj = (T*)free_list_;
-			free_list_ = *(void**)obj;
+	template <typename... Args>
+	T* New(Args&&... args) {
+		const uint32_t slot = Detail::CurrentThreadSlot();
+		void* mem = nullptr;
+		if (slot != Detail::kSharedHeap) [[likely]] {
+			mem = Allocate(slot);
 		} else {
-			if (size_ < sizeof(T)) {
-				size_ = 128 * N;
-				memory_ = (char*)SystemAlloc(size_);
-				if (memory_ == nullptr) [[unlikely]]{
-					LogErrorDetail("ObjectPool malloc false!");
-				}
+			std::lock_guard lock(shared_lock_);
+			mem = Allocate(slot);
+		}
+		if (mem == nullptr) [[unlikely]] {
+			return nullptr;
+		}
+		return new (mem) T(std::forward<Args>(args)...); //placement new
+	}
+
+	// Drops every reservation at once; live objects are not destroyed.
+	// Must not race with New/Delete.
+	void Release() {
+		for (const auto& region : regions_) {
+			SystemRelease(region);
+		}
+		regions_.clear();
+		reserve_cursor_ = reserve_end_ = nullptr;
+		MemoryTracker::RecordFree(Tag, slab_count_.exchange(0, std::memory_order_relaxed) * kSlabSize);
+		for (auto& slot : heaps_) {
+			if (ThreadHeap* heap = slot.load(std::memory_order_relaxed)) {
+				heap->local_free_ = nullptr;
+				heap->bump_ = heap->bump_end_ = nullptr;
+				heap->remote_free_.store(nullptr, std::memory_order_relaxed);
 			}
-			obj = (T*)memory_;
-			
-			size_t objsize = sizeof(T) < sizeof(void*) ? sizeof(void*) : sizeof(T);
-			memory_ += objsize;
-			size_ -= objsize;
 		}
+	}
+
+	size_t SlabCount() const noexcept { return slab_count_.load(std::memory_order_relaxed); }
+	static constexpr size_t SlabSize() noexcept { return kSlabSize; }
+	static constexpr size_t ObjectsPerSlab() noexcept { return (kSlabSize - kHeaderSize) / kStride; }
 
-		new (obj) T; //placement new
-		return obj;
+private:
+	static SlabHeader* SlabOf(const void* obj) noexcept {
+		return reinterpret_cast<SlabHeader*>(reinterpret_cast<uintptr_t>(obj) & kSlabMask);
 	}
 
-	void Release() {
-		if (memory_) {
-#if defined(_WIN32)
-			VirtualFree(memory_, 0, MEM_RELEASE);
-#elif defined(__linux__)
-			munmap(memory_, size_);
-#else
-    ::operator delete(ptr);
-#endif
-			memory_ = nullptr;
-			size_ = 0;
+	void* Allocate(uint32_t slot) {
+		ThreadHeap* heap = heaps_[slot].load(std::memory_order_relaxed);
+		if (heap == nullptr) [[unlikely]] {
+			//Only this slot's thread (or the shared lock holder) gets here
+			heap = new (std::nothrow) ThreadHeap();
+			if (heap == nullptr) {
+				return nullptr;
+			}
+			heaps_[slot].store(heap, std::memory_order_release);
 		}
-		free_list_ = nullptr;
+		if (heap->local_free_ == nullptr) [[unlikely]] {
+			heap->local_free_ = heap->remote_free_.exchange(nullptr, std::memory_order_acquire);
+		}
+		if (FreeNode* node = heap->local_free_) [[likely]] {
+			heap->local_free_ = node->next;
+			return node;
+		}
+		if (heap->bump_ == heap->bump_end_) [[unlikely]] {
+			char* slab = AcquireSlab(slot);
+			if (slab == nullptr) {
+				return nullptr;
+			}
+			heap->bump_ = slab + kHeaderSize;
+			heap->bump_end_ = heap->bump_ + ObjectsPerSlab() * kStride;
+		}
+		void* mem = heap->bump_;
+		heap->bump_ += kStride;
+		return mem;
+	}
+
+	char* AcquireSlab(uint32_t owner) {
+		std::lock_guard lock(grow_lock_);
+		if (reserve_cursor_ == reserve_end_) {
+			//Over-reserve one slab so the first slab can be aligned to kSlabSize
+			auto region = SystemReserve(kSlabSize * (kSlabsPerReserve + 1), policy_);
+			if (region.ptr == nullptr) [[unlikely]] {
+				LogErrorDetail("ObjectPool malloc false!");
+				return nullptr;
+			}
+			regions_.push_back(region);
+			auto base = (reinterpret_cast<uintptr_t>(region.ptr) + kSlabSize - 1) & kSlabMask;
+			reserve_cursor_ = reinterpret_cast<char*>(base);
+			reserve_end_ = reserve_cursor_ + kSlabSize * kSlabsPerReserve;
+		}
+		char* slab = reserve_cursor_;
+		if (!SystemCommit(regions_.back(), slab, kSlabSize)) [[unlikely]] {
+			LogErrorDetail("ObjectPool commit false!");
+			return nullptr;
+		}
+		reserve_cursor_ += kSlabSize;
+		reinterpret_cast<SlabHeader*>(slab)->owner_ = owner;
+		slab_count_.fetch_add(1, std::memory_order_relaxed);
+		MemoryTracker::RecordAlloc(Tag, kSlabSize);
+		return slab;
 	}
 };
 
-} //namespace Core::Memoory
+} //namespace Core::Memory
 
-#endif
\ No newline at end of file
+#endif
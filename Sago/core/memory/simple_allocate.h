@@ -1,9 +1,14 @@
 #ifndef SG_MEMORY_ALLOCATE_H
 #define SG_MEMORY_ALLOCATE_H
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <limits>
+#include <memory_resource>
 #include <mutex>
+#include <new>
+#include <type_traits>
 #include <vector>
 
 
@@ -53,74 +58,176 @@ private:
 	size_type allocCount;
 };
 
-template <class T>
-class PoolAllocator {
-    struct MemoryBlock {
-        T* data;                  
-        size_t used = 0;       
-        MemoryBlock* next = nullptr;
-    };
-
-    static inline thread_local MemoryBlock* tls_block = nullptr;  // 线程本地块
-    static inline std::mutex global_mutex;
-    static inline std::vector<MemoryBlock*> global_pool;         // 全局备用池
-};
+namespace Core::Memory {
 
+/**
+ * @brief Block arena shared by every PoolAllocator<T> and the pmr resource
+ * Each thread bumps inside its own block. A block keeps a live count plus one
+ * reference held by the owning thread; whoever drops it to zero (owner on retire,
+ * or the last deallocate from any thread) returns it to global_pool.
+ */
+class PoolBlockArena {
+public:
+	static constexpr size_t BLOCK_SIZE = 64 * 1024;
+	static constexpr size_t LARGE_ALLOCATION = BLOCK_SIZE / 4;
 
-/*
-pointer allocate(size_type n) {
+private:
+	struct MemoryBlock {
+		std::atomic<size_t> used{ 0 }; //live allocations + owner reference
+		size_t offset = 0;
+	};
 
-    if (!tls_block || tls_block->used + n > BLOCK_SIZE) {
-        tls_block = GetOrCreateBlock(); 
-    }
-    
-    T* ptr = &tls_block->data[tls_block->used];
-    tls_block->used += n;
-    return ptr;
-}
+	static constexpr size_t kHeaderSize = (sizeof(MemoryBlock) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
 
-void deallocate(pointer p, size_type n) {
-    MemoryBlock* block = FindBlockContaining(p);
-    
-    block->used -= n;
-    
+	struct ThreadBlock {
+		MemoryBlock* block = nullptr;
+		~ThreadBlock() { Retire(block); }
+	};
 
-    if (block->used == 0) {
-        std::lock_guard lock(global_mutex);
-        global_pool.push_back(block);
-    }
-}
+	//Blocks are kept until process exit, containers may outlive static teardown
+	struct GlobalPool {
+		std::mutex global_mutex;
+		std::vector<MemoryBlock*> blocks;
+	};
 
+	static ThreadBlock& tls_block() {
+		thread_local ThreadBlock block;
+		return block;
+	}
 
-using TransformVector = std::vector<Transform, PoolAllocator<Transform>>;
-TransformVector transforms; 
-
-
-MemoryBlock* GetOrCreateBlock() {
-    {
-        std::lock_guard lock(global_mutex);
-        if (!global_pool.empty()) {
-            auto* block = global_pool.back();
-            global_pool.pop_back();
-            return block;
-        }
-    }
-    
-  
-    auto* block = new MemoryBlock;
-    block->data = static_cast<T*>(::operator new(BLOCK_SIZE * sizeof(T)));
-    return block;
-}
+	//Leaked on purpose: a static pool would be destroyed at exit while static and
+	//thread_local containers still free into it
+	static GlobalPool& global_pool() {
+		static GlobalPool* pool = new GlobalPool;
+		return *pool;
+	}
 
+public:
+	static void* Allocate(size_t bytes, size_t alignment) {
+		if (bytes + alignment > LARGE_ALLOCATION || alignment > alignof(std::max_align_t) * 4) [[unlikely]] {
+			return ::operator new(bytes, std::align_val_t(alignment));
+		}
+
+		auto*& block = tls_block().block;
+		size_t offset = 0;
+		if (block != nullptr) {
+			offset = (block->offset + alignment - 1) & ~(alignment - 1);
+		}
+		if (block == nullptr || offset + bytes > BLOCK_SIZE) [[unlikely]] {
+			Retire(block);
+			block = GetOrCreateBlock();
+			offset = (block->offset + alignment - 1) & ~(alignment - 1);
+		}
+
+		block->offset = offset + bytes;
+		block->used.fetch_add(1, std::memory_order_relaxed);
+		return reinterpret_cast<char*>(block) + offset;
+	}
 
-*/
+	static void Deallocate(void* p, size_t bytes, size_t alignment) noexcept {
+		if (bytes + alignment > LARGE_ALLOCATION || alignment > alignof(std::max_align_t) * 4) [[unlikely]] {
+			::operator delete(p, std::align_val_t(alignment));
+			return;
+		}
+		MemoryBlock* block = FindBlockContaining(p);
+		if (block->used.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			Recycle(block);
+		}
+	}
 
+private:
+	static MemoryBlock* FindBlockContaining(void* p) noexcept {
+		return reinterpret_cast<MemoryBlock*>(reinterpret_cast<uintptr_t>(p) & ~(BLOCK_SIZE - 1));
+	}
 
+	static MemoryBlock* GetOrCreateBlock() {
+		MemoryBlock* block = nullptr;
+		{
+			auto& pool = global_pool();
+			std::lock_guard lock(pool.global_mutex);
+			if (!pool.blocks.empty()) {
+				block = pool.blocks.back();
+				pool.blocks.pop_back();
+			}
+		}
+		if (block == nullptr) {
+			block = new (::operator new(BLOCK_SIZE, std::align_val_t(BLOCK_SIZE))) MemoryBlock;
+		}
+		block->offset = kHeaderSize;
+		block->used.store(1, std::memory_order_relaxed); //owner reference
+		return block;
+	}
 
+	static void Retire(MemoryBlock* block) noexcept {
+		if (block != nullptr && block->used.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			Recycle(block);
+		}
+	}
 
+	static void Recycle(MemoryBlock* block) noexcept {
+		auto& pool = global_pool();
+		std::lock_guard lock(pool.global_mutex);
+		pool.blocks.push_back(block);
+	}
+};
 
+// std::vector<Transform, PoolAllocator<Transform>>
+template <class T>
+class PoolAllocator {
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using difference_type = std::ptrdiff_t;
+	using propagate_on_container_move_assignment = std::true_type;
+	using is_always_equal = std::true_type;
+
+	template <class U>
+	struct rebind {
+		using other = PoolAllocator<U>;
+	};
+
+	PoolAllocator() noexcept = default;
+	template <class U>
+	PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+	[[nodiscard]] T* allocate(size_type n) {
+		if (n > max_size()) [[unlikely]] {
+			throw std::bad_array_new_length();
+		}
+		return static_cast<T*>(PoolBlockArena::Allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* p, size_type n) noexcept {
+		PoolBlockArena::Deallocate(p, n * sizeof(T), alignof(T));
+	}
+
+	static constexpr size_type max_size() noexcept {
+		return (std::numeric_limits<size_type>::max)() / sizeof(T);
+	}
+
+	template <class U>
+	friend constexpr bool operator==(const PoolAllocator&, const PoolAllocator<U>&) noexcept { return true; }
+};
 
+// std::pmr::vector<Transform> transforms{ GetPoolResource() };
+class PoolMemoryResource : public std::pmr::memory_resource {
+private:
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		return PoolBlockArena::Allocate(bytes, alignment);
+	}
+	void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+		PoolBlockArena::Deallocate(p, bytes, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return dynamic_cast<const PoolMemoryResource*>(&other) != nullptr;
+	}
+};
 
+inline std::pmr::memory_resource* GetPoolResource() noexcept {
+	static PoolMemoryResource resource;
+	return &resource;
+}
 
+} //namespace Core::Memory
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,130 @@
+#include "memory_tracker.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include "core/io/log/log.h"
+
+namespace Core::Memory {
+
+namespace {
+
+struct TrackerState {
+	std::mutex mutex;
+	std::vector<void*> shards;
+	//Counters of threads that already exited
+	std::array<int64_t, kMemoryTagCount> retired_allocations{};
+	std::array<uint64_t, kMemoryTagCount> retired_total{};
+	std::array<int64_t, kMemoryTagCount> retired_bytes{};
+	std::array<int64_t, kMemoryTagCount> retired_peak{};
+	std::array<std::atomic<size_t>, kMemoryTagCount> budgets{};
+	std::array<bool, kMemoryTagCount> over_budget{};
+	MemoryTracker::GpuStatsProvider gpu_provider;
+};
+
+TrackerState& State() {
+	static TrackerState state;
+	return state;
+}
+
+} //namespace
+
+MemoryTracker::Shard::Shard() {
+	auto& state = State();
+	std::lock_guard lock(state.mutex);
+	state.shards.push_back(this);
+}
+
+MemoryTracker::Shard::~Shard() {
+	auto& state = State();
+	std::lock_guard lock(state.mutex);
+	for (size_t i = 0; i < kMemoryTagCount; ++i) {
+		state.retired_allocations[i] += counters[i].allocations.load(std::memory_order_relaxed);
+		state.retired_total[i] += counters[i].total.load(std::memory_order_relaxed);
+		state.retired_bytes[i] += counters[i].bytes.load(std::memory_order_relaxed);
+		state.retired_peak[i] += counters[i].peak.load(std::memory_order_relaxed);
+	}
+	std::erase(state.shards, this);
+}
+
+void MemoryTracker::SetBudget(MemoryTag tag, size_t bytes) noexcept {
+	State().budgets[static_cast<size_t>(tag)].store(bytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::SetGpuStatsProvider(GpuStatsProvider provider) {
+	auto& state = State();
+	std::lock_guard lock(state.mutex);
+	state.gpu_provider = std::move(provider);
+}
+
+MemoryReport MemoryTracker::Snapshot() {
+	MemoryReport report{};
+	auto& state = State();
+	std::lock_guard lock(state.mutex);
+
+	for (size_t i = 0; i < kMemoryTagCount; ++i) {
+		auto& tag = report.tags[i];
+		tag.allocations = state.retired_allocations[i];
+		tag.total_allocations = state.retired_total[i];
+		tag.bytes = state.retired_bytes[i];
+		tag.high_water = state.retired_peak[i];
+	}
+	for (void* ptr : state.shards) {
+		const auto* shard = static_cast<const Shard*>(ptr);
+		for (size_t i = 0; i < kMemoryTagCount; ++i) {
+			report.tags[i].allocations += shard->counters[i].allocations.load(std::memory_order_relaxed);
+			report.tags[i].total_allocations += shard->counters[i].total.load(std::memory_order_relaxed);
+			report.tags[i].bytes += shard->counters[i].bytes.load(std::memory_order_relaxed);
+			report.tags[i].high_water += shard->counters[i].peak.load(std::memory_order_relaxed);
+		}
+	}
+	for (size_t i = 0; i < kMemoryTagCount; ++i) {
+		report.tags[i].high_water = (std::max)(report.tags[i].high_water, report.tags[i].bytes);
+		report.tags[i].budget = state.budgets[i].load(std::memory_order_relaxed);
+	}
+
+	if (state.gpu_provider) {
+		report.gpu = state.gpu_provider();
+		report.has_gpu = true;
+	}
+	return report;
+}
+
+void MemoryTracker::CheckBudgets() {
+	if constexpr (!Enabled()) {
+		return;
+	}
+	auto report = Snapshot();
+	auto& state = State();
+	for (size_t i = 0; i < kMemoryTagCount; ++i) {
+		const auto& tag = report.tags[i];
+		const bool over = tag.budget != 0 && tag.bytes > static_cast<int64_t>(tag.budget);
+		//Warn on the transition only, not every frame
+		if (over && !state.over_budget[i]) {
+			LogWarring("[Memory][Budget] {} uses {} bytes, budget {} bytes",
+					MemoryTagName(static_cast<MemoryTag>(i)), tag.bytes, tag.budget);
+		}
+		state.over_budget[i] = over;
+	}
+}
+
+void MemoryTracker::PrintReport() {
+	auto report = Snapshot();
+	LogInfo("=== Memory Report ===");
+	if constexpr (Enabled()) {
+		for (size_t i = 0; i < kMemoryTagCount; ++i) {
+			const auto& tag = report.tags[i];
+			LogInfo("[CPU] {}: {} bytes, {} live / {} total allocations, peak {} bytes",
+					MemoryTagName(static_cast<MemoryTag>(i)), tag.bytes, tag.allocations,
+					tag.total_allocations, tag.high_water);
+		}
+	}
+	if (report.has_gpu) {
+		LogInfo("[GPU] {} / {} bytes in {} allocations, budget {} bytes",
+				report.gpu.used_bytes, report.gpu.allocated_bytes,
+				report.gpu.allocation_count, report.gpu.budget_bytes);
+	}
+	LogInfo("=====================");
+}
+
+} //namespace Core::Memory
@@ -0,0 +1,206 @@
+#ifndef SG_MEMORY_TRACKER_H
+#define SG_MEMORY_TRACKER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+//Opt-in: configure with -DSAGA_MEMORY_TRACKING=ON, otherwise every hook compiles away
+
+namespace Core::Memory {
+
+enum class MemoryTag : uint8_t {
+	kGeneral = 0,
+	kECS,
+	kLog,
+	kEvent,
+	kRenderer,
+	kAsset,
+	kCount
+};
+
+inline constexpr size_t kMemoryTagCount = static_cast<size_t>(MemoryTag::kCount);
+
+constexpr std::string_view MemoryTagName(MemoryTag tag) {
+	constexpr std::array<std::string_view, kMemoryTagCount> names = {
+		"General", "ECS", "Log", "Event", "Renderer", "Asset"
+	};
+	return names[static_cast<size_t>(tag)];
+}
+
+struct TagStats {
+	int64_t bytes = 0;
+	int64_t allocations = 0; //live
+	uint64_t total_allocations = 0;
+	int64_t high_water = 0;
+	size_t budget = 0; //0 = unlimited
+};
+
+//Filled by the renderer (VMA), reported next to the CPU tags
+struct GpuMemoryStats {
+	size_t allocated_bytes = 0; //device memory blocks
+	size_t used_bytes = 0; //sub-allocations
+	size_t allocation_count = 0;
+	size_t budget_bytes = 0;
+};
+
+struct MemoryReport {
+	std::array<TagStats, kMemoryTagCount> tags{};
+	GpuMemoryStats gpu{};
+	bool has_gpu = false;
+};
+
+class MemoryTracker {
+public:
+	using GpuStatsProvider = std::function<GpuMemoryStats()>;
+
+#if defined(SAGA_MEMORY_TRACKING)
+	static void RecordAlloc(MemoryTag tag, size_t bytes) noexcept {
+		auto& counter = LocalShard().counters[static_cast<size_t>(tag)];
+		//Only the owning thread writes, aggregation reads relaxed
+		counter.allocations.store(counter.allocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		counter.total.store(counter.total.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		const int64_t now = counter.bytes.load(std::memory_order_relaxed) + static_cast<int64_t>(bytes);
+		counter.bytes.store(now, std::memory_order_relaxed);
+		if (now > counter.peak.load(std::memory_order_relaxed)) {
+			counter.peak.store(now, std::memory_order_relaxed);
+		}
+	}
+
+	//A free on another thread than the allocation drives this shard negative, the sum balances
+	static void RecordFree(MemoryTag tag, size_t bytes) noexcept {
+		auto& counter = LocalShard().counters[static_cast<size_t>(tag)];
+		counter.allocations.store(counter.allocations.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+		counter.bytes.store(counter.bytes.load(std::memory_order_relaxed) - static_cast<int64_t>(bytes), std::memory_order_relaxed);
+	}
+#else
+	static void RecordAlloc(MemoryTag, size_t) noexcept {}
+	static void RecordFree(MemoryTag, size_t) noexcept {}
+#endif
+	static constexpr bool Enabled() noexcept {
+#if defined(SAGA_MEMORY_TRACKING)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	static void SetBudget(MemoryTag tag, size_t bytes) noexcept;
+	static void SetGpuStatsProvider(GpuStatsProvider provider);
+
+	//Aggregates all shards. high_water sums each thread's own peak: exact when one thread
+	//does a tag's allocations, otherwise an upper bound, never missing a peak between snapshots
+	static MemoryReport Snapshot();
+	//Once per frame: warns when a tag crosses its budget
+	static void CheckBudgets();
+	static void PrintReport();
+
+private:
+	struct alignas(64) Counter {
+		std::atomic<int64_t> allocations{ 0 };
+		std::atomic<uint64_t> total{ 0 };
+		std::atomic<int64_t> bytes{ 0 }; //live, allocated minus freed on this thread
+		std::atomic<int64_t> peak{ 0 }; //high-water of bytes
+	};
+
+	struct Shard {
+		std::array<Counter, kMemoryTagCount> counters{};
+		Shard();
+		~Shard();
+	};
+
+	static Shard& LocalShard() noexcept {
+		thread_local Shard shard;
+		return shard;
+	}
+};
+
+#if defined(SAGA_MEMORY_TRACKING)
+// std::vector<Component, TrackedAllocator<Component, MemoryTag::kECS>>
+template <class T, MemoryTag Tag = MemoryTag::kGeneral>
+class TrackedAllocator {
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using difference_type = std::ptrdiff_t;
+	using propagate_on_container_move_assignment = std::true_type;
+	using is_always_equal = std::true_type;
+
+	template <class U>
+	struct rebind {
+		using other = TrackedAllocator<U, Tag>;
+	};
+
+	TrackedAllocator() noexcept = default;
+	template <class U>
+	TrackedAllocator(const TrackedAllocator<U, Tag>&) noexcept {}
+
+	[[nodiscard]] T* allocate(size_type n) {
+		if (n > (std::numeric_limits<size_type>::max)() / sizeof(T)) [[unlikely]] {
+			throw std::bad_array_new_length();
+		}
+		MemoryTracker::RecordAlloc(Tag, n * sizeof(T));
+		if constexpr (kOverAligned) {
+			return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+		} else {
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		}
+	}
+
+	void deallocate(T* p, size_type n) noexcept {
+		MemoryTracker::RecordFree(Tag, n * sizeof(T));
+		if constexpr (kOverAligned) {
+			::operator delete(p, std::align_val_t(alignof(T)));
+		} else {
+			::operator delete(p);
+		}
+	}
+
+	template <class U>
+	friend constexpr bool operator==(const TrackedAllocator&, const TrackedAllocator<U, Tag>&) noexcept { return true; }
+
+private:
+	static constexpr bool kOverAligned = alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+};
+#else
+//Nothing to record, containers keep the plain allocator
+template <class T, MemoryTag Tag = MemoryTag::kGeneral>
+using TrackedAllocator = std::allocator<T>;
+#endif
+
+// pmr: tags any upstream resource
+class TrackedResource : public std::pmr::memory_resource {
+public:
+	explicit TrackedResource(MemoryTag tag, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) :
+			tag_(tag), upstream_(upstream) {}
+
+private:
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		MemoryTracker::RecordAlloc(tag_, bytes);
+		return upstream_->allocate(bytes, alignment);
+	}
+	void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+		MemoryTracker::RecordFree(tag_, bytes);
+		upstream_->deallocate(p, bytes, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+
+private:
+	MemoryTag tag_;
+	std::pmr::memory_resource* upstream_;
+};
+
+} //namespace Core::Memory
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef SG_COARSE_CLOCK_H
+#define SG_COARSE_CLOCK_H
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string_view>
+#if defined(_M_X64)
+	#include <intrin.h>
+#elif defined(__x86_64__)
+	#include <x86intrin.h>
+#endif
+
+namespace Core::Time {
+
+/**
+ * @brief Clock sampled once per batch by its owner thread
+ * Readers get the cached monotonic time and a wall-clock text that is only
+ * re-formatted when the second changes. Not thread-safe, one owner.
+ * Other threads stamp events with Ticks(), a raw counter read; the owner turns
+ * the stamps into monotonic time against its last sample.
+ */
+class CoarseClock {
+public:
+	CoarseClock() { Update(); }
+
+	//Any thread: TSC on x86-64, steady clock nanoseconds elsewhere
+	static uint64_t Ticks() noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+		return __rdtsc();
+#else
+		using namespace std::chrono;
+		return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+#endif
+	}
+
+	void Update() noexcept {
+		using namespace std::chrono;
+		ticks_ = Ticks();
+		monotonic_ns_ = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+		const auto wall = system_clock::now();
+		wall_ns_ = duration_cast<nanoseconds>(wall.time_since_epoch()).count();
+#if defined(__x86_64__) || defined(_M_X64)
+		//Tick rate measured since the first sample, sharper the longer the clock runs
+		if (base_ticks_ == 0) {
+			base_ticks_ = ticks_;
+			base_ns_ = monotonic_ns_;
+		} else if (ticks_ > base_ticks_) {
+			ns_per_tick_ = static_cast<double>(monotonic_ns_ - base_ns_) / static_cast<double>(ticks_ - base_ticks_);
+		}
+#endif
+		FormatWall(system_clock::to_time_t(wall));
+	}
+
+	//Monotonic time of a Ticks() stamp taken near the last Update
+	int64_t ToMonotonicNs(uint64_t ticks) const noexcept {
+		const auto age = static_cast<int64_t>(ticks_ - ticks);
+		return monotonic_ns_ - static_cast<int64_t>(static_cast<double>(age) * ns_per_tick_);
+	}
+
+	int64_t MonotonicNs() const noexcept { return monotonic_ns_; }
+	int64_t WallNs() const noexcept { return wall_ns_; }
+	std::string_view WallText() const noexcept { return { wall_text_, wall_length_ }; }
+
+	//Wall text of a monotonic time, re-formatted only when it falls in another second
+	std::string_view WallTextAt(int64_t monotonic_ns) noexcept {
+		constexpr int64_t kNsPerSecond = 1'000'000'000;
+		const int64_t wall_ns = wall_ns_ + (monotonic_ns - monotonic_ns_);
+		const int64_t seconds = wall_ns >= 0 ? wall_ns / kNsPerSecond : (wall_ns - kNsPerSecond + 1) / kNsPerSecond;
+		FormatWall(static_cast<std::time_t>(seconds));
+		return WallText();
+	}
+
+private:
+	void FormatWall(std::time_t seconds) noexcept {
+		if (seconds == cached_seconds_) {
+			return;
+		}
+		cached_seconds_ = seconds;
+		std::tm tm_buf;
+#ifdef _WIN32
+		localtime_s(&tm_buf, &seconds);
+#else
+		localtime_r(&seconds, &tm_buf);
+#endif
+		wall_length_ = std::strftime(wall_text_, sizeof(wall_text_), "[%Y-%m-%d %H:%M:%S]", &tm_buf);
+	}
+
+private:
+	uint64_t ticks_ = 0;
+	int64_t monotonic_ns_ = 0;
+	int64_t wall_ns_ = 0;
+	uint64_t base_ticks_ = 0;
+	int64_t base_ns_ = 0;
+	double ns_per_tick_ = 1.0;
+	std::time_t cached_seconds_ = -1;
+	size_t wall_length_ = 0;
+	char wall_text_[32] = {};
+};
+
+} //namespace Core::Time
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef SG_UTIL_DELEGATE_H
+#define SG_UTIL_DELEGATE_H
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Core::util {
+
+template <typename Signature, size_t Size = 4 * sizeof(void*)>
+class Delegate;
+
+/**
+ * @brief Move-only std::function replacement that never allocates
+ * The callable lives in an inline buffer; anything larger than Size is rejected at
+ * compile time. Trivially copyable callables (plain lambdas, [this], [&]) skip the
+ * manage hook entirely, so moving them is a memcpy.
+ */
+template <typename R, typename... Args, size_t Size>
+class Delegate<R(Args...), Size> {
+	using InvokeFn = R (*)(const void*, Args...);
+	using ManageFn = void (*)(void* dst, void* src) noexcept; //dst == nullptr: destroy src
+
+public:
+	Delegate() noexcept = default;
+
+	Delegate(R (*fn)(Args...)) noexcept {
+		if (fn != nullptr) {
+			Bind(fn);
+		}
+	}
+
+	template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Delegate>>>
+	Delegate(F&& fn) noexcept(std::is_nothrow_constructible_v<std::decay_t<F>, F&&>) {
+		Bind(std::forward<F>(fn));
+	}
+
+	Delegate(Delegate&& other) noexcept { MoveFrom(other); }
+
+	Delegate& operator=(Delegate&& other) noexcept {
+		if (this != &other) {
+			Reset();
+			MoveFrom(other);
+		}
+		return *this;
+	}
+
+	Delegate(const Delegate&) = delete;
+	Delegate& operator=(const Delegate&) = delete;
+
+	~Delegate() { Reset(); }
+
+	R operator()(Args... args) const {
+		return invoke_(storage_, std::forward<Args>(args)...);
+	}
+
+	explicit operator bool() const noexcept { return invoke_ != nullptr; }
+
+	void Reset() noexcept {
+		if (manage_ != nullptr) {
+			manage_(nullptr, storage_);
+		}
+		invoke_ = nullptr;
+		manage_ = nullptr;
+	}
+
+private:
+	template <typename F>
+	void Bind(F&& fn) {
+		using Fn = std::decay_t<F>;
+		static_assert(sizeof(Fn) <= Size, "Callable too large for Delegate, capture less or raise Size");
+		static_assert(alignof(Fn) <= alignof(std::max_align_t), "Over-aligned callable");
+		static_assert(std::is_nothrow_move_constructible_v<Fn>, "Callable must be nothrow movable");
+
+		::new (static_cast<void*>(storage_)) Fn(std::forward<F>(fn));
+		invoke_ = [](const void* self, Args... args) -> R {
+			return (*static_cast<Fn*>(const_cast<void*>(self)))(std::forward<Args>(args)...);
+		};
+		if constexpr (!std::is_trivially_copyable_v<Fn>) {
+			manage_ = [](void* dst, void* src) noexcept {
+				auto* from = static_cast<Fn*>(src);
+				if (dst != nullptr) {
+					::new (dst) Fn(std::move(*from));
+				}
+				from->~Fn();
+			};
+		}
+	}
+
+	void MoveFrom(Delegate& other) noexcept {
+		invoke_ = other.invoke_;
+		manage_ = other.manage_;
+		if (manage_ != nullptr) {
+			manage_(storage_, other.storage_);
+		} else if (invoke_ != nullptr) {
+			std::memcpy(storage_, other.storage_, Size);
+		}
+		other.invoke_ = nullptr;
+		other.manage_ = nullptr;
+	}
+
+private:
+	alignas(std::max_align_t) mutable std::byte storage_[Size];
+	InvokeFn invoke_ = nullptr;
+	ManageFn manage_ = nullptr;
+};
+
+} //namespace Core::util
+
+#endif
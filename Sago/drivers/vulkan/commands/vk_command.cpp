@@ -76,9 +76,9 @@ void VulkanCommand::EndRecording() {
 	isrecording_ = false;
 }
 
-void VulkanCommand::Submit(const std::vector<VkSemaphore>& waitSemaphores,
-		const std::vector<VkPipelineStageFlags>& waitStages,
-		const std::vector<VkSemaphore>& signalSemaphores,
+void VulkanCommand::Submit(std::span<const VkSemaphore> waitSemaphores,
+		std::span<const VkPipelineStageFlags> waitStages,
+		std::span<const VkSemaphore> signalSemaphores,
 		VkFence fence) {
 	VkSubmitInfo submitInfo{};
 	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -97,12 +97,43 @@ void VulkanCommand::Submit(const std::vector<VkSemaphore>& waitSemaphores,
 	}
 }
 
-std::pair<VkResult, std::string> VulkanCommand::Present(VkQueue presentQueue, const std::vector<VkSemaphore>& signalSemaphores,
+void VulkanCommand::Submit(std::span<const VkSemaphore> waitSemaphores,
+		std::span<const VkPipelineStageFlags> waitStages,
+		std::span<const uint64_t> waitValues,
+		std::span<const VkSemaphore> signalSemaphores,
+		std::span<const uint64_t> signalValues,
+		VkFence fence) {
+	VkTimelineSemaphoreSubmitInfo timelineInfo{};
+	timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+	timelineInfo.waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size());
+	timelineInfo.pWaitSemaphoreValues = waitValues.data();
+	timelineInfo.signalSemaphoreValueCount = static_cast<uint32_t>(signalValues.size());
+	timelineInfo.pSignalSemaphoreValues = signalValues.data();
+
+	VkSubmitInfo submitInfo{};
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.pNext = &timelineInfo;
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandbuffer_;
+
+	submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
+	submitInfo.pWaitSemaphores = waitSemaphores.data();
+	submitInfo.pWaitDstStageMask = waitStages.data();
+
+	submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
+	submitInfo.pSignalSemaphores = signalSemaphores.data();
+
+	if (vkQueueSubmit(queue_, 1, &submitInfo, fence) != VK_SUCCESS) [[unlikely]] {
+		LogErrorDetail("[Vulkan][Command] Failed To submit");
+	}
+}
+
+std::pair<VkResult, std::string> VulkanCommand::Present(VkQueue presentQueue, std::span<const VkSemaphore> signalSemaphores,
 		VkSwapchainKHR swapchain, uint32_t imageindex) const {
 	VkPresentInfoKHR presentInfo{};
 	presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 
-	presentInfo.waitSemaphoreCount = signalSemaphores.size();
+	presentInfo.waitSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
 	presentInfo.pWaitSemaphores = signalSemaphores.data();
 
 	VkSwapchainKHR swapChains[] = { swapchain };
@@ -3,8 +3,9 @@
 
 #include <volk.h>
 #include <cstdint>
-#include <vector>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace Driver::Vulkan {
 
@@ -26,12 +27,20 @@ public:
 	void BeginRecording();
 	void EndRecording();
 
-	void Submit(const std::vector<VkSemaphore>& waitSemaphores,
-			const std::vector<VkPipelineStageFlags>& waitStages,
-			const std::vector<VkSemaphore>& signalSemaphores,
+	void Submit(std::span<const VkSemaphore> waitSemaphores,
+			std::span<const VkPipelineStageFlags> waitStages,
+			std::span<const VkSemaphore> signalSemaphores,
+			VkFence fence);
+
+	//Values run parallel to the semaphores, entries for binary semaphores are ignored
+	void Submit(std::span<const VkSemaphore> waitSemaphores,
+			std::span<const VkPipelineStageFlags> waitStages,
+			std::span<const uint64_t> waitValues,
+			std::span<const VkSemaphore> signalSemaphores,
+			std::span<const uint64_t> signalValues,
 			VkFence fence);
 
-	std::pair<VkResult, std::string> Present(VkQueue presentQueue, const std::vector<VkSemaphore>& signalSemaphores,
+	std::pair<VkResult, std::string> Present(VkQueue presentQueue, std::span<const VkSemaphore> signalSemaphores,
 			VkSwapchainKHR swapchain, uint32_t imageindex) const;
 
 	bool IsRecording() { return isrecording_; }
@@ -5,15 +5,14 @@
 
 namespace Driver::Vulkan {
 
-void CommandBuilder::CheckInRenderPass() const {
-	if (!inRenderPass_) {
-		LogErrorDetail("[Vulkan][CommandBuilder] Command requires render pass to be active!");
-	}
+void CommandBuilder::ReportNotInRenderPass() {
+	LogErrorDetail("[Vulkan][CommandBuilder] Command requires render pass to be active!");
 }
 
 CommandBuilder& CommandBuilder::BeginRenderPass(VkRenderPass renderPass, VkFramebuffer framebuffer,
 		VkExtent2D extent,
-		const std::vector<VkClearValue>& clearValues) {
+		std::span<const VkClearValue> clearValues,
+		VkSubpassContents contents) {
 	if (inRenderPass_) {
 		LogErrorDetail("[Vulkan][CommandBuilder] Already in render pass!");
 		return *this;
@@ -34,8 +33,9 @@ CommandBuilder& CommandBuilder::BeginRenderPass(VkRenderPass renderPass, VkFrame
 		renderPassInfo.pClearValues = clearValues.data();
 	}
 
-	vkCmdBeginRenderPass(cmdBuffer_, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+	vkCmdBeginRenderPass(cmdBuffer_, &renderPassInfo, contents);
 	inRenderPass_ = true;
+	graphics_pipeline_ = VK_NULL_HANDLE;
 	return *this;
 }
 
@@ -47,13 +47,19 @@ CommandBuilder& CommandBuilder::EndRenderPass() {
 
 	vkCmdEndRenderPass(cmdBuffer_);
 	inRenderPass_ = false;
+	//Secondaries executed inside the pass leave the bound state undefined
+	graphics_pipeline_ = VK_NULL_HANDLE;
 	return *this;
 }
 
 //Pipeline
 CommandBuilder& CommandBuilder::BindGraphicsPipeline(VkPipeline pipeline) {
 	CheckInRenderPass();
+	if (pipeline == graphics_pipeline_) {
+		return *this;
+	}
 	vkCmdBindPipeline(cmdBuffer_, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+	graphics_pipeline_ = pipeline;
 	return *this;
 }
 
@@ -108,8 +114,8 @@ CommandBuilder& CommandBuilder::DrawIndexed(uint32_t indexCount, uint32_t instan
 }
 
 CommandBuilder& CommandBuilder::BindVertexBuffers(uint32_t firstBinding,
-		const std::vector<VkBuffer>& buffers,
-		const std::vector<VkDeviceSize>& offsets) {
+		std::span<const VkBuffer> buffers,
+		std::span<const VkDeviceSize> offsets) {
 	CheckInRenderPass();
 	vkCmdBindVertexBuffers(cmdBuffer_, firstBinding,
 			static_cast<uint32_t>(buffers.size()),
@@ -126,8 +132,8 @@ CommandBuilder& CommandBuilder::BindIndexBuffer(VkBuffer buffer, VkDeviceSize of
 
 CommandBuilder& CommandBuilder::BindDescriptorSets(VkPipelineBindPoint pipelineBindPoint,
 		VkPipelineLayout layout, uint32_t firstSet,
-		const std::vector<VkDescriptorSet>& descriptorSets,
-		const std::vector<uint32_t>& dynamicOffsets) {
+		std::span<const VkDescriptorSet> descriptorSets,
+		std::span<const uint32_t> dynamicOffsets) {
 	vkCmdBindDescriptorSets(cmdBuffer_, pipelineBindPoint, layout, firstSet,
 			static_cast<uint32_t>(descriptorSets.size()),
 			descriptorSets.data(),
@@ -136,16 +142,9 @@ CommandBuilder& CommandBuilder::BindDescriptorSets(VkPipelineBindPoint pipelineB
 	return *this;
 }
 
-template <typename T>
-CommandBuilder& CommandBuilder::PushConstants(VkPipelineLayout layout, VkShaderStageFlags stageFlags,
-		uint32_t offset, const T& data) {
-	vkCmdPushConstants(cmdBuffer_, layout, stageFlags, offset, sizeof(T), &data);
-	return *this;
-}
-
 //Buffer Input
 CommandBuilder& CommandBuilder::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer,
-		const std::vector<VkBufferCopy>& regions) {
+		std::span<const VkBufferCopy> regions) {
 	vkCmdCopyBuffer(cmdBuffer_, srcBuffer, dstBuffer,
 			static_cast<uint32_t>(regions.size()), regions.data());
 	return *this;
@@ -153,7 +152,7 @@ CommandBuilder& CommandBuilder::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffe
 
 CommandBuilder& CommandBuilder::CopyBufferToImage(VkBuffer srcBuffer, VkImage dstImage,
 		VkImageLayout dstImageLayout,
-		const std::vector<VkBufferImageCopy>& regions) {
+		std::span<const VkBufferImageCopy> regions) {
 	vkCmdCopyBufferToImage(cmdBuffer_, srcBuffer, dstImage, dstImageLayout,
 			static_cast<uint32_t>(regions.size()), regions.data());
 	return *this;
@@ -162,9 +161,9 @@ CommandBuilder& CommandBuilder::CopyBufferToImage(VkBuffer srcBuffer, VkImage ds
 CommandBuilder& CommandBuilder::PipelineBarrier(VkPipelineStageFlags srcStageMask,
 		VkPipelineStageFlags dstStageMask,
 		VkDependencyFlags dependencyFlags,
-		const std::vector<VkMemoryBarrier>& memoryBarriers,
-		const std::vector<VkBufferMemoryBarrier>& bufferMemoryBarriers,
-		const std::vector<VkImageMemoryBarrier>& imageMemoryBarriers) {
+		std::span<const VkMemoryBarrier> memoryBarriers,
+		std::span<const VkBufferMemoryBarrier> bufferMemoryBarriers,
+		std::span<const VkImageMemoryBarrier> imageMemoryBarriers) {
 	vkCmdPipelineBarrier(cmdBuffer_, srcStageMask, dstStageMask, dependencyFlags,
 			static_cast<uint32_t>(memoryBarriers.size()), memoryBarriers.data(),
 			static_cast<uint32_t>(bufferMemoryBarriers.size()), bufferMemoryBarriers.data(),
@@ -1,24 +1,37 @@
 #ifndef SG_VULKAN_COMMANDBUILD_H
 #define SG_VULKAN_COMMANDBUILD_H
 #include "vk_command.h"
+#include <initializer_list>
+#include <span>
 
 namespace Driver::Vulkan {
 
+/**
+ * @brief Chained command recording
+ * Lists are taken as std::span (arrays, vectors, anything contiguous) or as braced
+ * lists, whose backing arrays live on the stack; recording never allocates.
+ * Render pass validation only exists in debug builds.
+ */
 class CommandBuilder {
 public:
 	explicit CommandBuilder(VulkanCommand& command) :
-			command_(command) {
-		if (!command_.IsRecording()) {
-			command_.BeginRecording();
+			command_(&command) {
+		if (!command_->IsRecording()) {
+			command_->BeginRecording();
 		}
-		cmdBuffer_ = command_.getHandle();
+		cmdBuffer_ = command_->getHandle();
 	}
 
+	//Already begun by the caller, e.g. a secondary continuing a render pass
+	CommandBuilder(VkCommandBuffer commandBuffer, bool inRenderPass) :
+			cmdBuffer_(commandBuffer), inRenderPass_(inRenderPass) {}
+
 	CommandBuilder(const CommandBuilder&) = delete;
 	CommandBuilder& operator=(const CommandBuilder&) = delete;
 	CommandBuilder& BeginRenderPass(VkRenderPass renderPass, VkFramebuffer framebuffer,
 			VkExtent2D extent,
-			const std::vector<VkClearValue>& clearValues = {});
+			std::span<const VkClearValue> clearValues = {},
+			VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
 	CommandBuilder& EndRenderPass();
 
 	CommandBuilder& BindGraphicsPipeline(VkPipeline pipeline);
@@ -42,35 +55,74 @@ public:
 			uint32_t firstInstance = 0);
 
 	CommandBuilder& BindVertexBuffers(uint32_t firstBinding,
-			const std::vector<VkBuffer>& buffers,
-			const std::vector<VkDeviceSize>& offsets);
+			std::span<const VkBuffer> buffers,
+			std::span<const VkDeviceSize> offsets);
+	CommandBuilder& BindVertexBuffers(uint32_t firstBinding,
+			std::initializer_list<VkBuffer> buffers,
+			std::initializer_list<VkDeviceSize> offsets) {
+		return BindVertexBuffers(firstBinding, std::span(buffers.begin(), buffers.size()),
+				std::span(offsets.begin(), offsets.size()));
+	}
 
 	CommandBuilder& BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset,
 			VkIndexType indexType);
 
 	CommandBuilder& BindDescriptorSets(VkPipelineBindPoint pipelineBindPoint,
 			VkPipelineLayout layout, uint32_t firstSet,
-			const std::vector<VkDescriptorSet>& descriptorSets,
-			const std::vector<uint32_t>& dynamicOffsets = {});
+			std::span<const VkDescriptorSet> descriptorSets,
+			std::span<const uint32_t> dynamicOffsets = {});
+	CommandBuilder& BindDescriptorSets(VkPipelineBindPoint pipelineBindPoint,
+			VkPipelineLayout layout, uint32_t firstSet,
+			std::initializer_list<VkDescriptorSet> descriptorSets,
+			std::initializer_list<uint32_t> dynamicOffsets = {}) {
+		return BindDescriptorSets(pipelineBindPoint, layout, firstSet,
+				std::span(descriptorSets.begin(), descriptorSets.size()),
+				std::span(dynamicOffsets.begin(), dynamicOffsets.size()));
+	}
 
 	//Push Constants
 	template <typename T>
 	CommandBuilder& PushConstants(VkPipelineLayout layout, VkShaderStageFlags stageFlags,
-			uint32_t offset, const T& data);
+			uint32_t offset, const T& data) {
+		vkCmdPushConstants(cmdBuffer_, layout, stageFlags, offset, sizeof(T), &data);
+		return *this;
+	}
 
 	CommandBuilder& CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer,
-			const std::vector<VkBufferCopy>& regions);
+			std::span<const VkBufferCopy> regions);
+	CommandBuilder& CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer,
+			std::initializer_list<VkBufferCopy> regions) {
+		return CopyBuffer(srcBuffer, dstBuffer, std::span(regions.begin(), regions.size()));
+	}
 
 	CommandBuilder& CopyBufferToImage(VkBuffer srcBuffer, VkImage dstImage,
 			VkImageLayout dstImageLayout,
-			const std::vector<VkBufferImageCopy>& regions);
+			std::span<const VkBufferImageCopy> regions);
+	CommandBuilder& CopyBufferToImage(VkBuffer srcBuffer, VkImage dstImage,
+			VkImageLayout dstImageLayout,
+			std::initializer_list<VkBufferImageCopy> regions) {
+		return CopyBufferToImage(srcBuffer, dstImage, dstImageLayout,
+				std::span(regions.begin(), regions.size()));
+	}
 
+	//The span form takes every list, braced lists may be left out from the back
 	CommandBuilder& PipelineBarrier(VkPipelineStageFlags srcStageMask,
 			VkPipelineStageFlags dstStageMask,
 			VkDependencyFlags dependencyFlags,
-			const std::vector<VkMemoryBarrier>& memoryBarriers = {},
-			const std::vector<VkBufferMemoryBarrier>& bufferMemoryBarriers = {},
-			const std::vector<VkImageMemoryBarrier>& imageMemoryBarriers = {});
+			std::span<const VkMemoryBarrier> memoryBarriers,
+			std::span<const VkBufferMemoryBarrier> bufferMemoryBarriers,
+			std::span<const VkImageMemoryBarrier> imageMemoryBarriers);
+	CommandBuilder& PipelineBarrier(VkPipelineStageFlags srcStageMask,
+			VkPipelineStageFlags dstStageMask,
+			VkDependencyFlags dependencyFlags,
+			std::initializer_list<VkMemoryBarrier> memoryBarriers = {},
+			std::initializer_list<VkBufferMemoryBarrier> bufferMemoryBarriers = {},
+			std::initializer_list<VkImageMemoryBarrier> imageMemoryBarriers = {}) {
+		return PipelineBarrier(srcStageMask, dstStageMask, dependencyFlags,
+				std::span(memoryBarriers.begin(), memoryBarriers.size()),
+				std::span(bufferMemoryBarriers.begin(), bufferMemoryBarriers.size()),
+				std::span(imageMemoryBarriers.begin(), imageMemoryBarriers.size()));
+	}
 
 	CommandBuilder& Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
 
@@ -83,12 +135,21 @@ public:
 	VkCommandBuffer GetCommandBuffer() const { return cmdBuffer_; }
 
 private:
-	void CheckInRenderPass() const;
+	void CheckInRenderPass() const {
+#if !defined(NDEBUG)
+		if (!inRenderPass_) [[unlikely]] {
+			ReportNotInRenderPass();
+		}
+#endif
+	}
+	static void ReportNotInRenderPass();
 
 private:
-	VulkanCommand& command_;
+	VulkanCommand* command_ = nullptr;
 	VkCommandBuffer cmdBuffer_;
 	bool inRenderPass_{ false };
+	//Shared pipelines make back-to-back binds of the same one common, those are skipped
+	VkPipeline graphics_pipeline_ = VK_NULL_HANDLE;
 };
 
 } //namespace Driver::Vulkan
@@ -0,0 +1,52 @@
+#include "vk_frame_timeline.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace Driver::Vulkan {
+
+VulkanFrameTimeline::VulkanFrameTimeline(VkDevice device) :
+		semaphore_(device, 0) {
+}
+
+VulkanFrameTimeline::~VulkanFrameTimeline() {
+	//The owner waits for the device first, everything queued is safe to run
+	RunCompleted(UINT64_MAX);
+}
+
+uint64_t VulkanFrameTimeline::Poll() {
+	const uint64_t completed = semaphore_.getCounterValue();
+	completed_.store(completed, std::memory_order_release);
+	RunCompleted(completed);
+	return completed;
+}
+
+void VulkanFrameTimeline::Wait(uint64_t frame) {
+	if (frame != 0 && !IsComplete(frame)) {
+		semaphore_.wait(frame);
+	}
+	Poll();
+}
+
+void VulkanFrameTimeline::DeferUntil(uint64_t frame, std::function<void()> callback) {
+	std::lock_guard lock(deferred_mutex_);
+	deferred_.push_back({ frame, std::move(callback) });
+}
+
+void VulkanFrameTimeline::RunCompleted(uint64_t completed) {
+	{
+		std::lock_guard lock(deferred_mutex_);
+		auto ready = std::stable_partition(deferred_.begin(), deferred_.end(),
+				[completed](const Deferred& deferred) { return deferred.frame_ > completed; });
+		std::move(ready, deferred_.end(), std::back_inserter(running_));
+		deferred_.erase(ready, deferred_.end());
+	}
+	//Callbacks may defer more work
+	for (auto& deferred : running_) {
+		deferred.callback_();
+	}
+	running_.clear();
+}
+
+} //namespace Driver::Vulkan
@@ -0,0 +1,64 @@
+#ifndef SG_VULKAN_FRAME_TIMELINE_H
+#define SG_VULKAN_FRAME_TIMELINE_H
+#include "vk_semaphore.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace Driver::Vulkan {
+
+/**
+ * @brief Frame counter of the graphics queue, backed by one timeline semaphore
+ * Frame N's submit signals the semaphore with N, so "the GPU is done with frame N"
+ * is a single comparison for every subsystem. Deferred work (resource frees) runs
+ * on the render thread once the frame it was queued in has completed.
+ */
+class VulkanFrameTimeline {
+public:
+	explicit VulkanFrameTimeline(VkDevice device);
+	~VulkanFrameTimeline();
+
+	VulkanFrameTimeline(const VulkanFrameTimeline&) = delete;
+	VulkanFrameTimeline& operator=(const VulkanFrameTimeline&) = delete;
+
+	VkSemaphore GetHandle() const noexcept { return semaphore_; }
+
+	//Frame being recorded, its submit signals this value
+	uint64_t Current() const noexcept { return current_.load(std::memory_order_acquire); }
+	//Newest frame known to be finished, as of the last Poll or Wait
+	uint64_t Completed() const noexcept { return completed_.load(std::memory_order_acquire); }
+	bool IsComplete(uint64_t frame) const noexcept { return frame <= Completed(); }
+
+	//Render thread
+	uint64_t Advance() noexcept { return current_.fetch_add(1, std::memory_order_acq_rel) + 1; }
+	uint64_t Poll();
+	void Wait(uint64_t frame); //then polls, 0 never blocks
+
+	//Any thread, runs once every frame that can still use the resource has finished.
+	//Current() is already submitted between frames, the next one may record with it
+	void Defer(std::function<void()> callback) { DeferUntil(Current() + 1, std::move(callback)); }
+	//Runs after `frame` has finished
+	void DeferUntil(uint64_t frame, std::function<void()> callback);
+
+private:
+	void RunCompleted(uint64_t completed);
+
+private:
+	VulkanSemaphore semaphore_;
+	std::atomic<uint64_t> current_{ 0 };
+	std::atomic<uint64_t> completed_{ 0 };
+
+	struct Deferred {
+		uint64_t frame_;
+		std::function<void()> callback_;
+	};
+	std::mutex deferred_mutex_;
+	std::vector<Deferred> deferred_;
+	std::vector<Deferred> running_; //reused, keeps Poll free of allocations
+};
+
+} //namespace Driver::Vulkan
+
+#endif
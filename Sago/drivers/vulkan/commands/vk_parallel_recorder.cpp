@@ -0,0 +1,160 @@
+#include "vk_parallel_recorder.h"
+
+#include <algorithm>
+
+#include "core/io/log/log.h"
+
+namespace Driver::Vulkan {
+
+VulkanParallelRecorder::VulkanParallelRecorder(const VulkanDevice& device, uint32_t frames_in_flight, uint32_t lanes) :
+		device_(device.GetDevice()) {
+	if (lanes == 0) {
+		lanes = (std::max)(std::thread::hardware_concurrency(), 1u);
+	}
+	lane_count_ = std::clamp(lanes, 1u, kMaxLanes);
+
+	//Transient: reset every frame, never per buffer
+	lanes_.resize(size_t(frames_in_flight) * lane_count_);
+	for (auto& lane : lanes_) {
+		VkCommandPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		poolInfo.queueFamilyIndex = device.GetGraphicsFamily();
+		if (vkCreateCommandPool(device_, &poolInfo, nullptr, &lane.pool_) != VK_SUCCESS) {
+			LogErrorDetail("[Vulkan][Recorder] Failed To Create Command Pool");
+		}
+	}
+
+	workers_.reserve(lane_count_ - 1);
+	for (uint32_t lane = 1; lane < lane_count_; ++lane) {
+		workers_.emplace_back([this, lane](std::stop_token token) { WorkerLoop(token, lane); });
+	}
+}
+
+VulkanParallelRecorder::~VulkanParallelRecorder() {
+	for (auto& worker : workers_) {
+		worker.request_stop();
+	}
+	dispatch_.fetch_add(uint64_t(1) << 8, std::memory_order_release);
+	dispatch_.notify_all();
+	workers_.clear();
+
+	for (auto& lane : lanes_) {
+		//Frees the secondaries with it
+		vkDestroyCommandPool(device_, lane.pool_, nullptr);
+	}
+}
+
+void VulkanParallelRecorder::BeginFrame(uint32_t slot) {
+	slot_ = slot;
+	for (uint32_t i = 0; i < lane_count_; ++i) {
+		Lane& lane = lanes_[size_t(slot_) * lane_count_ + i];
+		vkResetCommandPool(device_, lane.pool_, 0);
+		lane.used_ = 0;
+	}
+}
+
+uint32_t VulkanParallelRecorder::ChunkCount(size_t draws) const noexcept {
+	if (draws == 0) {
+		return 0;
+	}
+	const size_t wanted = (draws + kMinChunkDraws - 1) / kMinChunkDraws;
+	return static_cast<uint32_t>((std::min)(wanted, size_t(lane_count_) * kChunksPerLane));
+}
+
+void VulkanParallelRecorder::RecordChunks(VkCommandBuffer primary, const Inheritance& inheritance,
+		uint32_t chunks, ChunkFn fn) {
+	if (chunks == 0) {
+		return;
+	}
+	job_ = &fn;
+	inheritance_ = inheritance;
+	chunk_count_ = chunks;
+	chunk_buffers_.resize(chunks);
+	next_chunk_.store(0, std::memory_order_relaxed);
+
+	//Only wake as many workers as there are chunks to share
+	const uint32_t helpers = (std::min)(lane_count_ - 1, chunks - 1);
+	if (helpers != 0) {
+		pending_.store(helpers, std::memory_order_relaxed);
+		const uint64_t generation = (dispatch_.load(std::memory_order_relaxed) >> 8) + 1;
+		dispatch_.store(generation << 8 | helpers, std::memory_order_release);
+		dispatch_.notify_all();
+	}
+
+	RunLane(0);
+
+	for (uint32_t left = pending_.load(std::memory_order_acquire); left != 0;
+			left = pending_.load(std::memory_order_acquire)) {
+		pending_.wait(left, std::memory_order_acquire);
+	}
+	job_ = nullptr;
+
+	vkCmdExecuteCommands(primary, chunks, chunk_buffers_.data());
+}
+
+VkCommandBuffer VulkanParallelRecorder::NextBuffer(Lane& lane) {
+	if (lane.used_ == lane.buffers_.size()) [[unlikely]] {
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.commandPool = lane.pool_;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+		allocInfo.commandBufferCount = 1;
+
+		VkCommandBuffer buffer = VK_NULL_HANDLE;
+		if (vkAllocateCommandBuffers(device_, &allocInfo, &buffer) != VK_SUCCESS) [[unlikely]] {
+			LogErrorDetail("[Vulkan][Recorder] Failed To Allocate Secondary CommandBuffer");
+		}
+		lane.buffers_.push_back(buffer);
+	}
+	return lane.buffers_[lane.used_++];
+}
+
+void VulkanParallelRecorder::RunLane(uint32_t index) {
+	Lane& lane = lanes_[size_t(slot_) * lane_count_ + index];
+
+	VkCommandBufferInheritanceInfo inheritanceInfo{};
+	inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+	inheritanceInfo.renderPass = inheritance_.render_pass_;
+	inheritanceInfo.subpass = inheritance_.subpass_;
+	inheritanceInfo.framebuffer = inheritance_.framebuffer_;
+
+	VkCommandBufferBeginInfo beginInfo{};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+	for (uint32_t chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed); chunk < chunk_count_;
+			chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed)) {
+		VkCommandBuffer buffer = NextBuffer(lane);
+		if (vkBeginCommandBuffer(buffer, &beginInfo) != VK_SUCCESS) [[unlikely]] {
+			LogErrorDetail("[Vulkan][Recorder] Failed To Begin Secondary CommandBuffer");
+		}
+		CommandBuilder builder(buffer, true);
+		(*job_)(builder, chunk);
+		if (vkEndCommandBuffer(buffer) != VK_SUCCESS) [[unlikely]] {
+			LogErrorDetail("[Vulkan][Recorder] Failed To End Secondary CommandBuffer");
+		}
+		chunk_buffers_[chunk] = buffer;
+	}
+}
+
+void VulkanParallelRecorder::WorkerLoop(std::stop_token token, uint32_t lane) {
+	uint64_t seen = 0;
+	while (true) {
+		dispatch_.wait(seen, std::memory_order_acquire);
+		seen = dispatch_.load(std::memory_order_acquire);
+		if (token.stop_requested()) {
+			return;
+		}
+		if (lane > (seen & 0xFF)) {
+			continue;
+		}
+		RunLane(lane);
+		if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			pending_.notify_one();
+		}
+	}
+}
+
+} //namespace Driver::Vulkan
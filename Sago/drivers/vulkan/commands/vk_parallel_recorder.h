@@ -0,0 +1,97 @@
+#ifndef SG_VULKAN_PARALLEL_RECORDER_H
+#define SG_VULKAN_PARALLEL_RECORDER_H
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "core/util/delegate.h"
+#include "drivers/vulkan/vk_device.h"
+#include "vk_commandbuild.h"
+
+namespace Driver::Vulkan {
+
+/**
+ * @brief Records a draw list into secondary command buffers on worker threads
+ * Every lane (the render thread is lane 0) owns one VkCommandPool per frame slot,
+ * reset wholesale by BeginFrame; secondaries are allocated once and reused. Record
+ * cuts the list into fixed chunks, lanes pull chunk indices from an atomic counter
+ * and the primary executes the secondaries in chunk order, so the command stream
+ * does not depend on which thread recorded which chunk.
+ */
+class VulkanParallelRecorder {
+public:
+	static constexpr uint32_t kMaxLanes = 8;
+	static constexpr uint32_t kMinChunkDraws = 256; //smaller lists are not worth a wakeup
+	static constexpr uint32_t kChunksPerLane = 4; //slack for uneven chunks
+
+	struct Inheritance {
+		VkRenderPass render_pass_ = VK_NULL_HANDLE;
+		uint32_t subpass_ = 0;
+		VkFramebuffer framebuffer_ = VK_NULL_HANDLE;
+	};
+
+	//Builder is inside the render pass; secondaries inherit no state, set pipeline and dynamic state per chunk
+	using ChunkFn = Core::util::Delegate<void(CommandBuilder&, uint32_t)>;
+
+	VulkanParallelRecorder(const VulkanDevice& device, uint32_t frames_in_flight, uint32_t lanes = 0);
+	~VulkanParallelRecorder();
+
+	VulkanParallelRecorder(const VulkanParallelRecorder&) = delete;
+	VulkanParallelRecorder& operator=(const VulkanParallelRecorder&) = delete;
+
+	//Render thread, once the slot's previous frame has completed
+	void BeginFrame(uint32_t slot);
+
+	//Render thread, the primary must be inside a render pass begun with
+	//VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS; record(builder, draws) runs concurrently
+	template <typename T, typename Fn>
+	void Record(VkCommandBuffer primary, const Inheritance& inheritance,
+			std::span<const T> draws, Fn&& record) {
+		const size_t count = draws.size();
+		const uint32_t chunks = ChunkCount(count);
+		RecordChunks(primary, inheritance, chunks, [&](CommandBuilder& builder, uint32_t chunk) {
+			const size_t begin = count * chunk / chunks;
+			const size_t end = count * (chunk + 1) / chunks;
+			record(builder, draws.subspan(begin, end - begin));
+		});
+	}
+
+	uint32_t LaneCount() const noexcept { return lane_count_; }
+
+private:
+	struct Lane {
+		VkCommandPool pool_ = VK_NULL_HANDLE;
+		std::vector<VkCommandBuffer> buffers_;
+		uint32_t used_ = 0;
+	};
+
+	uint32_t ChunkCount(size_t draws) const noexcept;
+	void RecordChunks(VkCommandBuffer primary, const Inheritance& inheritance, uint32_t chunks, ChunkFn fn);
+	void RunLane(uint32_t lane);
+	VkCommandBuffer NextBuffer(Lane& lane);
+	void WorkerLoop(std::stop_token token, uint32_t lane);
+
+private:
+	VkDevice device_;
+	uint32_t lane_count_;
+	uint32_t slot_ = 0;
+	std::vector<Lane> lanes_; //[slot * lane_count_ + lane]
+
+	//Job of the current Record call, published by dispatch_
+	const ChunkFn* job_ = nullptr;
+	Inheritance inheritance_;
+	uint32_t chunk_count_ = 0;
+	std::vector<VkCommandBuffer> chunk_buffers_; //indexed by chunk, written by the recording lane
+	alignas(64) std::atomic<uint32_t> next_chunk_{ 0 };
+	//Generation << 8 | helper lanes, one load gives workers a consistent view
+	alignas(64) std::atomic<uint64_t> dispatch_{ 0 };
+	alignas(64) std::atomic<uint32_t> pending_{ 0 };
+
+	std::vector<std::jthread> workers_;
+};
+
+} //namespace Driver::Vulkan
+
+#endif
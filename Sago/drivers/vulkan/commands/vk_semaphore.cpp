@@ -9,6 +9,11 @@ VulkanSemaphore::VulkanSemaphore(const VkDevice device) :
 	createSemaphore();
 }
 
+VulkanSemaphore::VulkanSemaphore(const VkDevice device, uint64_t initialValue) :
+		device_(device), value_(initialValue), isTimeline_(true) {
+	createTimelineSemaphore();
+}
+
 VulkanSemaphore::~VulkanSemaphore() {
 	if (semaphore_ != VK_NULL_HANDLE) {
 		vkDestroySemaphore(device_, semaphore_, nullptr);
@@ -51,7 +56,49 @@ void VulkanSemaphore::createSemaphore() {
     }
 }
 
+void VulkanSemaphore::createTimelineSemaphore() {
+	VkSemaphoreTypeCreateInfo typeInfo{};
+	typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+	typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+	typeInfo.initialValue = value_;
+
+	VkSemaphoreCreateInfo semaphoreInfo{};
+	semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+	semaphoreInfo.pNext = &typeInfo;
+
+	if (vkCreateSemaphore(device_, &semaphoreInfo, nullptr, &semaphore_) != VK_SUCCESS) {
+		LogErrorDetail("[Vulkan] Failed to create timeline semaphore!");
+	}
+}
+
+uint64_t VulkanSemaphore::getCounterValue() const {
+	uint64_t value = 0;
+	if (vkGetSemaphoreCounterValue(device_, semaphore_, &value) != VK_SUCCESS) [[unlikely]] {
+		LogErrorDetail("[Vulkan] Failed to read timeline semaphore!");
+	}
+	return value;
+}
 
+void VulkanSemaphore::signal(uint64_t value) {
+	VkSemaphoreSignalInfo signalInfo{};
+	signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+	signalInfo.semaphore = semaphore_;
+	signalInfo.value = value;
 
+	if (vkSignalSemaphore(device_, &signalInfo) != VK_SUCCESS) [[unlikely]] {
+		LogErrorDetail("[Vulkan] Failed to signal timeline semaphore!");
+	}
+	value_ = value;
+}
+
+bool VulkanSemaphore::wait(uint64_t value, uint64_t timeout) const {
+	VkSemaphoreWaitInfo waitInfo{};
+	waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+	waitInfo.semaphoreCount = 1;
+	waitInfo.pSemaphores = &semaphore_;
+	waitInfo.pValues = &value;
+
+	return vkWaitSemaphores(device_, &waitInfo, timeout) == VK_SUCCESS;
+}
 
 } //namespace Driver::Vulkan
\ No newline at end of file
@@ -1,12 +1,15 @@
 #ifndef SG_VULKAN_SEMAPHORE_H
 #define SG_VULKAN_SEMAPHORE_H
 #include <volk.h>
+#include <cstdint>
 
 namespace Driver::Vulkan {
 
 class VulkanSemaphore {
 public:
 	VulkanSemaphore(const VkDevice device);
+	//Time Line
+	VulkanSemaphore(const VkDevice device, uint64_t initialValue);
 	~VulkanSemaphore();
 
 	VulkanSemaphore(const VulkanSemaphore&) = delete;
@@ -17,12 +20,15 @@ public:
 	VkSemaphore getHandle() const { return semaphore_; }
 	operator VkSemaphore() const { return semaphore_; }
 	//Time Line
-	uint64_t getValue() const { return value_; }
+	bool isTimeline() const { return isTimeline_; }
+	uint64_t getValue() const { return value_; } //last value signaled from the host
+	uint64_t getCounterValue() const; //value reached on the device
 	void signal(uint64_t value);
-	bool wait(uint64_t value, uint64_t timeout = UINT64_MAX);
+	bool wait(uint64_t value, uint64_t timeout = UINT64_MAX) const;
 
 private:
 	void createSemaphore();
+	void createTimelineSemaphore();
 
 private:
 	VkDevice device_{ VK_NULL_HANDLE };
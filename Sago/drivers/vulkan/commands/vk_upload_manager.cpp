@@ -1,90 +1,161 @@
 #include "vk_upload_manager.h"
-#include "vk_fence.h"
 #include <cstdint>
 
+#include "core/io/log/log.h"
 #include "drivers/vulkan/commands/vk_commandbuild.h"
 
 namespace Driver::Vulkan {
 using namespace Driver::Vulkan::Memory;
-VulkanUploadManager::VulkanUploadManager(const VulkanDevice& device, uint32_t queueFamilyIndex) :
-		device_(device) {
+
+namespace {
+
+constexpr VkPipelineStageFlags kReadStages = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT |
+		VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+		VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+constexpr VkAccessFlags kBufferReadAccess = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT |
+		VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+} //namespace
+
+VulkanUploadManager::VulkanUploadManager(const VulkanDevice& device, VulkanAllocator& allocator) :
+		device_(device), allocator_(allocator), dedicated_(device.HasDedicatedTransfer()) {
 	upload_pool_ = std::make_unique<VulkanCommandPool>(
-			device.GetDevice(), queueFamilyIndex);
-	upload_command_ = upload_pool_->CreateCommand(device.GetGraphyciQueue());
-	upload_fence_ = std::make_unique<VulkanFence>(device.GetDevice(), 0);
+			device.GetDevice(), device.GetTransferFamily());
+	timeline_ = std::make_unique<VulkanSemaphore>(device.GetDevice(), 0);
+	for (auto& batch : batches_) {
+		batch.command_ = upload_pool_->CreateCommand(device.GetTransferQueue());
+	}
+}
+
+VulkanUploadManager::~VulkanUploadManager() {
+	std::lock_guard lock(mutex_);
+	for (auto& batch : batches_) {
+		if (batch.recording_) {
+			//Never submitted, the copies are dropped
+			batch.command_->EndRecording();
+			batch.recording_ = false;
+			batch.submitted_ = true;
+		} else if (batch.submitted_) {
+			timeline_->wait(batch.ticket_);
+		}
+		if (batch.submitted_) {
+			Retire(batch);
+		}
+	}
 }
 
-void VulkanUploadManager::UploadBufferData(
-		VulkanAllocator& allocator,
-		const VulkanAllocator::Buffer& srcStaging,
-		const VulkanAllocator::Buffer& dstDevice) {
-	upload_command_->Reset();
-	upload_command_->BeginRecording();
+VulkanUploadManager::Batch& VulkanUploadManager::OpenBatch() {
+	Batch& batch = batches_[open_];
+	if (batch.recording_) [[likely]] {
+		return batch;
+	}
+	if (batch.submitted_) [[unlikely]] {
+		//Every batch is in flight, the oldest one has to finish first
+		timeline_->wait(batch.ticket_);
+		RetireFinished();
+	}
+	batch.command_->Reset();
+	batch.command_->BeginRecording(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+	batch.ticket_ = next_ticket_++;
+	batch.recording_ = true;
+	return batch;
+}
+
+void VulkanUploadManager::ReleaseBuffer(Batch& batch, VkBuffer buffer,
+		VkDeviceSize offset, VkDeviceSize size) {
+	if (!dedicated_) {
+		return;
+	}
+	VkBufferMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = 0;
+	barrier.srcQueueFamilyIndex = device_.GetTransferFamily();
+	barrier.dstQueueFamilyIndex = device_.GetGraphicsFamily();
+	barrier.buffer = buffer;
+	barrier.offset = offset;
+	barrier.size = size;
+	batch.buffer_releases_.push_back(barrier);
+}
+
+UploadTicket VulkanUploadManager::UploadBufferData(
+		VulkanAllocator::Buffer&& srcStaging,
+		const VulkanAllocator::Buffer& dstDevice,
+		VkDeviceSize dstOffset) {
+	std::lock_guard lock(mutex_);
+	Batch& batch = OpenBatch();
 	{
-		CommandBuilder builder(*upload_command_);
+		CommandBuilder builder(*batch.command_);
 		VkBufferCopy copyRegion{};
 		copyRegion.srcOffset = 0;
-		copyRegion.dstOffset = 0;
+		copyRegion.dstOffset = dstOffset;
 		copyRegion.size = srcStaging.GetSize();
 
 		builder.CopyBuffer(
 				srcStaging.buffer,
 				dstDevice.buffer,
 				{ copyRegion });
+		ReleaseBuffer(batch, dstDevice.buffer, dstOffset, copyRegion.size);
 	}
-	upload_command_->EndRecording();
+	batch.staging_.push_back(std::move(srcStaging));
+	return { batch.ticket_ };
+}
 
-	SubmitAndWait();
+UploadTicket VulkanUploadManager::UploadBufferData(
+		const StagingAllocation& srcStaging,
+		const VulkanAllocator::Buffer& dstDevice,
+		VkDeviceSize dstOffset) {
+	std::lock_guard lock(mutex_);
+	Batch& batch = OpenBatch();
+	{
+		CommandBuilder builder(*batch.command_);
+		VkBufferCopy copyRegion{};
+		copyRegion.srcOffset = srcStaging.offset;
+		copyRegion.dstOffset = dstOffset;
+		copyRegion.size = srcStaging.size;
+
+		builder.CopyBuffer(
+				srcStaging.buffer,
+				dstDevice.buffer,
+				{ copyRegion });
+		ReleaseBuffer(batch, dstDevice.buffer, dstOffset, copyRegion.size);
+	}
+	return { batch.ticket_ };
 }
 
-void VulkanUploadManager::UploadMultipleBuffers(
-		Memory::VulkanAllocator& allocator,
-		const std::vector<std::pair<
-				const Memory::VulkanAllocator::Buffer&, // srcStaging
-				const Memory::VulkanAllocator::Buffer& // dstDevice
-				>>& bufferPairs) {
-	upload_command_->Reset();
-	upload_command_->BeginRecording();
+UploadTicket VulkanUploadManager::UploadMultipleBuffers(
+		std::vector<std::pair<
+				VulkanAllocator::Buffer, // srcStaging
+				const VulkanAllocator::Buffer& // dstDevice
+				>>&& bufferPairs) {
+	std::lock_guard lock(mutex_);
+	Batch& batch = OpenBatch();
 	{
-		CommandBuilder builder(*upload_command_);
+		CommandBuilder builder(*batch.command_);
 
-		for (const auto& [src, dst] : bufferPairs) {
+		for (auto& [src, dst] : bufferPairs) {
 			VkBufferCopy copyRegion{};
 			copyRegion.srcOffset = 0;
 			copyRegion.dstOffset = 0;
 			copyRegion.size = src.GetSize();
 
 			builder.CopyBuffer(src.buffer, dst.buffer, { copyRegion });
+			ReleaseBuffer(batch, dst.buffer, 0, copyRegion.size);
+			batch.staging_.push_back(std::move(src));
 		}
 	}
-	upload_command_->EndRecording();
-	SubmitAndWait();
-}
-
-void VulkanUploadManager::SubmitAndWait() {
-	upload_fence_->reset();
-
-	VkSubmitInfo submitInfo{};
-	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-	submitInfo.commandBufferCount = 1;
-
-	VkCommandBuffer commandBuffer = upload_command_->getHandle();
-	submitInfo.pCommandBuffers = &commandBuffer;
-
-	vkQueueSubmit(device_.GetGraphyciQueue(), 1, &submitInfo, *upload_fence_);
-	upload_fence_->wait(UINT64_MAX);
+	return { batch.ticket_ };
 }
 
-void VulkanUploadManager::UploadBufferToImage(
-		Memory::VulkanAllocator& allocator,
-		const Memory::VulkanAllocator::Buffer& srcStaging,
-		const Memory::VulkanAllocator::Image& dstImage,
+UploadTicket VulkanUploadManager::UploadBufferToImage(
+		VulkanAllocator::Buffer&& srcStaging,
+		const VulkanAllocator::Image& dstImage,
 		VkImageLayout finalLayout,
 		uint32_t width, uint32_t height, uint32_t mipLevels) {
-	upload_command_->Reset();
-	upload_command_->BeginRecording();
+	std::lock_guard lock(mutex_);
+	Batch& batch = OpenBatch();
 	{
-		CommandBuilder builder(*upload_command_);
+		CommandBuilder builder(*batch.command_);
 
 		// Transition
 		builder.TransitionImageLayout(
@@ -111,16 +182,190 @@ void VulkanUploadManager::UploadBufferToImage(
 				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 				{ region });
 
-		builder.TransitionImageLayout(
-				dstImage.image,
-				VK_FORMAT_UNDEFINED,
-				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-				finalLayout,
-				mipLevels);
+		if (dedicated_) {
+			//The layout change is part of the ownership transfer, repeated by the acquire
+			VkImageMemoryBarrier barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = 0;
+			barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+			barrier.newLayout = finalLayout;
+			barrier.srcQueueFamilyIndex = device_.GetTransferFamily();
+			barrier.dstQueueFamilyIndex = device_.GetGraphicsFamily();
+			barrier.image = dstImage.image;
+			barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, mipLevels, 0, 1 };
+			batch.image_releases_.push_back(barrier);
+		} else {
+			builder.TransitionImageLayout(
+					dstImage.image,
+					VK_FORMAT_UNDEFINED,
+					VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+					finalLayout,
+					mipLevels);
+		}
+	}
+	batch.staging_.push_back(std::move(srcStaging));
+	return { batch.ticket_ };
+}
+
+UploadTicket VulkanUploadManager::Flush() {
+	std::lock_guard lock(mutex_);
+	SubmitOpenBatch();
+	return { next_ticket_ - 1 };
+}
+
+void VulkanUploadManager::SubmitOpenBatch() {
+	Batch& batch = batches_[open_];
+	if (!batch.recording_) {
+		return;
 	}
-	upload_command_->EndRecording();
+	{
+		CommandBuilder builder(*batch.command_);
+		if (dedicated_) {
+			//Release half of the ownership transfers, RecordAcquires does the other
+			builder.PipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+					0, {}, batch.buffer_releases_, batch.image_releases_);
+		} else {
+			//Make the copies visible to everything later in submission order on this queue
+			VkMemoryBarrier barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = kBufferReadAccess;
+			builder.PipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, kReadStages, 0, { barrier });
+		}
+	}
+	batch.command_->EndRecording();
+
+	const VkSemaphore timeline = *timeline_;
+	VkTimelineSemaphoreSubmitInfo timelineInfo{};
+	timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+	timelineInfo.signalSemaphoreValueCount = 1;
+	timelineInfo.pSignalSemaphoreValues = &batch.ticket_;
+
+	VkSubmitInfo submitInfo{};
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.pNext = &timelineInfo;
+	submitInfo.commandBufferCount = 1;
+
+	VkCommandBuffer commandBuffer = batch.command_->getHandle();
+	submitInfo.pCommandBuffers = &commandBuffer;
+	submitInfo.signalSemaphoreCount = 1;
+	submitInfo.pSignalSemaphores = &timeline;
+
+	if (vkQueueSubmit(device_.GetTransferQueue(), 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) [[unlikely]] {
+		LogErrorDetail("[Vulkan][Upload] Failed To Submit Upload Batch");
+	}
+	batch.recording_ = false;
+	batch.submitted_ = true;
+	open_ = (open_ + 1) % kBatchCount;
+}
+
+void VulkanUploadManager::Retire(Batch& batch) {
+	for (auto& staging : batch.staging_) {
+		allocator_.DestroyBuffer(staging);
+	}
+	batch.staging_.clear();
+	batch.submitted_ = false;
+
+	if (!dedicated_) {
+		completed_.store(batch.ticket_, std::memory_order_release);
+		return;
+	}
+	//Same transfer seen from the graphics side
+	for (auto barrier : batch.buffer_releases_) {
+		barrier.srcAccessMask = 0;
+		barrier.dstAccessMask = kBufferReadAccess;
+		buffer_acquires_.push_back(barrier);
+	}
+	for (auto barrier : batch.image_releases_) {
+		barrier.srcAccessMask = 0;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		image_acquires_.push_back(barrier);
+	}
+	batch.buffer_releases_.clear();
+	batch.image_releases_.clear();
+	handoff_ = batch.ticket_;
+}
+
+void VulkanUploadManager::RetireFinished() {
+	const uint64_t reached = timeline_->getCounterValue();
+	//From open_ the ring runs oldest to newest, retire in order
+	for (uint32_t i = 0; i < kBatchCount; ++i) {
+		Batch& batch = batches_[(open_ + i) % kBatchCount];
+		if (!batch.submitted_) {
+			continue;
+		}
+		if (batch.ticket_ > reached) {
+			break;
+		}
+		Retire(batch);
+	}
+}
+
+void VulkanUploadManager::Collect(std::pmr::memory_resource* scratch) {
+	{
+		std::lock_guard lock(mutex_);
+		RetireFinished();
+	}
+	ResumeCompleted(scratch);
+}
+
+void VulkanUploadManager::ResumeCompleted(std::pmr::memory_resource* scratch) {
+	std::pmr::vector<std::coroutine_handle<>> ready(scratch);
+	{
+		std::lock_guard lock(mutex_);
+		const uint64_t completed = completed_.load(std::memory_order_relaxed);
+		std::erase_if(waiters_, [&](const Waiter& waiter) {
+			if (waiter.ticket_ > completed) {
+				return false;
+			}
+			ready.push_back(waiter.handle_);
+			return true;
+		});
+	}
+	//Resumed coroutines may queue more uploads
+	for (auto handle : ready) {
+		handle.resume();
+	}
+}
+
+uint64_t VulkanUploadManager::RecordAcquires(VkCommandBuffer commandBuffer) {
+	std::lock_guard lock(mutex_);
+	if (handoff_ == 0) {
+		return 0;
+	}
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, kReadStages, 0,
+			0, nullptr,
+			static_cast<uint32_t>(buffer_acquires_.size()), buffer_acquires_.data(),
+			static_cast<uint32_t>(image_acquires_.size()), image_acquires_.data());
+	buffer_acquires_.clear();
+	image_acquires_.clear();
+
+	const uint64_t wait = handoff_;
+	handoff_ = 0;
+	completed_.store(wait, std::memory_order_release);
+	return wait;
+}
+
+void VulkanUploadManager::Wait(UploadTicket ticket) {
+	if (IsComplete(ticket)) {
+		return;
+	}
+	{
+		std::lock_guard lock(mutex_);
+		if (batches_[open_].recording_ && batches_[open_].ticket_ == ticket.value_) {
+			SubmitOpenBatch();
+		}
+	}
+	//Copies done and staging released; with a dedicated transfer queue graphics
+	//can use the data after the next RecordAcquires
+	timeline_->wait(ticket.value_);
+	Collect();
+}
 
-	SubmitAndWait();
+void VulkanUploadManager::AddWaiter(UploadTicket ticket, std::coroutine_handle<> handle) {
+	std::lock_guard lock(mutex_);
+	waiters_.push_back({ ticket.value_, handle });
 }
 
-} //namespace Driver::Vulkan
\ No newline at end of file
+} //namespace Driver::Vulkan
@@ -2,44 +2,146 @@
 #define SG_VULKAN_UPLOAD_MANAGER_H
 #include "vk_command.h"
 #include "vk_commandpool.h"
-#include "vk_fence.h"
+#include "vk_semaphore.h"
+#include <drivers/vulkan/memory/vk_staging_ring.h>
 #include <drivers/vulkan/memory/vk_vma_allocator.h>
 #include <drivers/vulkan/vk_device.h>
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
 
 namespace Driver::Vulkan {
 
+//Id of the batch an upload was recorded into, batches complete in order
+struct UploadTicket {
+	uint64_t value_ = 0;
+};
+
+/**
+ * @brief Asynchronous staging uploads
+ * Copies are recorded into the open batch (any thread), Flush submits the batch
+ * with one vkQueueSubmit on the transfer queue, signaling a timeline semaphore
+ * with the batch ticket (render thread, it owns the queues). Collect polls the
+ * timeline without waiting, frees the staging buffers of finished batches and
+ * resumes coroutines awaiting their tickets.
+ * Without a dedicated transfer family every batch ends with a transfer -> read
+ * barrier on the graphics queue. With one, batches end with queue family release
+ * barriers; the matching acquires are handed to the graphics queue only once the
+ * copies have finished, so streaming never stalls a frame:
+ *   const uint64_t wait = upload.RecordAcquires(cmd);
+ *   //submit cmd waiting GetTimeline() >= wait when wait != 0
+ */
 class VulkanUploadManager {
 public:
-	VulkanUploadManager(const VulkanDevice&, uint32_t);
+	static constexpr uint32_t kBatchCount = 4;
+
+	VulkanUploadManager(const VulkanDevice&, Memory::VulkanAllocator&);
+	~VulkanUploadManager();
+
+	VulkanUploadManager(const VulkanUploadManager&) = delete;
+	VulkanUploadManager& operator=(const VulkanUploadManager&) = delete;
 
-	void UploadBufferData(Memory::VulkanAllocator& allocator,
-			const Memory::VulkanAllocator::Buffer& srcStaging,
-			const Memory::VulkanAllocator::Buffer& dstDevice);
+	//Staging buffers are owned by the manager until the copy has completed
+	UploadTicket UploadBufferData(Memory::VulkanAllocator::Buffer&& srcStaging,
+			const Memory::VulkanAllocator::Buffer& dstDevice,
+			VkDeviceSize dstOffset = 0);
 
-	void UploadMultipleBuffers(
-			Memory::VulkanAllocator& allocator,
-			const std::vector<std::pair<
-					const Memory::VulkanAllocator::Buffer&, // srcStaging
+	//Ring memory stays with the staging ring, wait the ticket before reusing it
+	UploadTicket UploadBufferData(const Memory::StagingAllocation& srcStaging,
+			const Memory::VulkanAllocator::Buffer& dstDevice,
+			VkDeviceSize dstOffset = 0);
+
+	UploadTicket UploadMultipleBuffers(
+			std::vector<std::pair<
+					Memory::VulkanAllocator::Buffer, // srcStaging
 					const Memory::VulkanAllocator::Buffer& // dstDevice
-					>>& bufferPairs);
+					>>&& bufferPairs);
 
-	void UploadBufferToImage(
-			Memory::VulkanAllocator& allocator,
-			const Memory::VulkanAllocator::Buffer& srcStaging,
+	UploadTicket UploadBufferToImage(
+			Memory::VulkanAllocator::Buffer&& srcStaging,
 			const Memory::VulkanAllocator::Image& dstImage,
 			VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
 			uint32_t width = 0, uint32_t height = 0, uint32_t mipLevels = 1);
+
+	//Render thread
+	UploadTicket Flush(); //newest ticket submitted so far
+	//scratch backs the list of coroutines to resume, the frame arena on the render thread
+	void Collect(std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+	void Wait(UploadTicket ticket);
+
+	//Render thread, records pending acquire barriers into a graphics command buffer
+	//being recorded; returns the timeline value its submit must wait on, 0 for none
+	uint64_t RecordAcquires(VkCommandBuffer commandBuffer);
+	VkSemaphore GetTimeline() const noexcept { return *timeline_; }
+	bool IsDedicated() const noexcept { return dedicated_; }
+
+	//Usable by graphics work recorded from now on
+	bool IsComplete(UploadTicket ticket) const noexcept {
+		return ticket.value_ <= completed_.load(std::memory_order_acquire);
+	}
+
+	struct Awaiter {
+		VulkanUploadManager& manager_;
+		UploadTicket ticket_;
+
+		bool await_ready() const noexcept { return manager_.IsComplete(ticket_); }
+		void await_suspend(std::coroutine_handle<> handle) { manager_.AddWaiter(ticket_, handle); }
+		void await_resume() const noexcept {}
+	};
+
+	//co_await upload.Await(ticket); resumed from Collect on the render thread
+	Awaiter Await(UploadTicket ticket) noexcept { return { *this, ticket }; }
+
 private:
-	void SubmitAndWait();
+	struct Batch {
+		std::unique_ptr<VulkanCommand> command_;
+		std::vector<Memory::VulkanAllocator::Buffer> staging_;
+		//Dedicated transfer only, replayed as acquires on the graphics queue
+		std::vector<VkBufferMemoryBarrier> buffer_releases_;
+		std::vector<VkImageMemoryBarrier> image_releases_;
+		uint64_t ticket_ = 0;
+		bool recording_ = false;
+		bool submitted_ = false;
+	};
+
+	struct Waiter {
+		uint64_t ticket_;
+		std::coroutine_handle<> handle_;
+	};
+
+	Batch& OpenBatch();
+	void SubmitOpenBatch();
+	void Retire(Batch& batch);
+	void RetireFinished();
+	void AddWaiter(UploadTicket ticket, std::coroutine_handle<> handle);
+	void ReleaseBuffer(Batch& batch, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size);
+	void ResumeCompleted(std::pmr::memory_resource* scratch);
 
 private:
 	const VulkanDevice& device_;
+	Memory::VulkanAllocator& allocator_;
+	const bool dedicated_;
 	std::unique_ptr<VulkanCommandPool> upload_pool_;
-	std::unique_ptr<VulkanCommand> upload_command_;
-	std::unique_ptr<VulkanFence> upload_fence_;
+	std::unique_ptr<VulkanSemaphore> timeline_; //reaches a batch ticket when its copies are done
+	std::array<Batch, kBatchCount> batches_;
+
+	std::mutex mutex_;
+	uint32_t open_ = 0; //index of the batch taking new copies
+	uint64_t next_ticket_ = 1;
+	std::atomic<uint64_t> completed_{ 0 };
+	std::vector<Waiter> waiters_;
+
+	//Copies finished on the transfer queue, ownership not yet acquired by graphics
+	std::vector<VkBufferMemoryBarrier> buffer_acquires_;
+	std::vector<VkImageMemoryBarrier> image_acquires_;
+	uint64_t handoff_ = 0;
 };
 
 } //namespace Driver::Vulkan
 
-#endif
\ No newline at end of file
+#endif
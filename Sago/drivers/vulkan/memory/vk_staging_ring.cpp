@@ -0,0 +1,75 @@
+#include "vk_staging_ring.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "drivers/vulkan/vk_log.h"
+
+namespace Driver::Vulkan::Memory {
+
+VulkanStagingRing::VulkanStagingRing(VulkanAllocator& allocator, uint32_t frames_in_flight,
+		VkDeviceSize capacity) :
+		allocator_(allocator),
+		partition_count_((std::max)(frames_in_flight, 1u) + 1),
+		partition_size_((capacity / partition_count_) & ~(kAlignment - 1)) {
+	ring_ = allocator_.CreateBuffer(
+			partition_size_ * partition_count_,
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+					VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+					VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+			VMA_MEMORY_USAGE_CPU_TO_GPU,
+			VMA_ALLOCATION_CREATE_MAPPED_BIT,
+			"StagingRing");
+	if (!ring_.IsMapped()) {
+		LogErrorDetail("[Vulkan][Memory] Failed To Map Staging Ring");
+		partition_size_ = 0;
+	}
+}
+
+VulkanStagingRing::~VulkanStagingRing() {
+	for (auto& buffer : dedicated_) {
+		allocator_.DestroyBuffer(buffer);
+	}
+	allocator_.DestroyBuffer(ring_);
+}
+
+void VulkanStagingRing::Flush() {
+	//No-op on coherent memory; only the bytes written since the last flush
+	const VkDeviceSize used = (std::min)(head_.load(std::memory_order_acquire), partition_size_);
+	if (used > flushed_) {
+		allocator_.FlushMemory(ring_.allocation, partition_base_ + flushed_, used - flushed_);
+		flushed_ = used;
+	}
+}
+
+std::vector<VulkanAllocator::Buffer> VulkanStagingRing::BeginFrame(uint64_t serial) {
+	Flush();
+
+	partition_ = static_cast<uint32_t>(serial % partition_count_);
+	partition_base_ = partition_size_ * partition_;
+	head_.store(0, std::memory_order_release);
+	flushed_ = 0;
+
+	std::lock_guard lock(dedicated_mutex_);
+	return std::exchange(dedicated_, {});
+}
+
+StagingAllocation VulkanStagingRing::AllocateDedicated(VkDeviceSize size) {
+	auto buffer = allocator_.CreateBuffer(
+			size,
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VMA_MEMORY_USAGE_CPU_ONLY,
+			VMA_ALLOCATION_CREATE_MAPPED_BIT,
+			"StagingDedicated");
+	if (!buffer.IsMapped()) [[unlikely]] {
+		LogErrorDetail("[Vulkan][Memory] Failed To Allocate Dedicated Staging Buffer");
+		return {};
+	}
+	StagingAllocation allocation{ buffer.buffer, 0, size, buffer.GerMappedData() };
+
+	std::lock_guard lock(dedicated_mutex_);
+	dedicated_.push_back(std::move(buffer));
+	return allocation;
+}
+
+} //namespace Driver::Vulkan::Memory
@@ -0,0 +1,101 @@
+#ifndef SG_VULKAN_MEMORY_STAGING_RING_H
+#define SG_VULKAN_MEMORY_STAGING_RING_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "vk_vma_allocator.h"
+
+namespace Driver::Vulkan::Memory {
+
+struct StagingAllocation {
+	VkBuffer buffer = VK_NULL_HANDLE;
+	VkDeviceSize offset = 0;
+	VkDeviceSize size = 0;
+	void* data = nullptr;
+
+	bool IsValid() const noexcept { return data != nullptr; }
+};
+
+/**
+ * @brief Persistently mapped staging ring, one partition per frame
+ * Allocate is a lock-free bump inside the current partition. BeginFrame(serial)
+ * switches partitions; it must be called once frame (serial - frames_in_flight)
+ * has completed. The ring keeps one partition more than frames in flight, so data
+ * written before a frame's uploads are flushed is only reused once the frame that
+ * submitted them has finished. Requests that do not fit get a dedicated buffer,
+ * handed back by BeginFrame when their partition is left; the caller frees them
+ * once the copies out of that partition are done.
+ */
+class VulkanStagingRing {
+public:
+	static constexpr VkDeviceSize kDefaultCapacity = VkDeviceSize(16) << 20;
+	//Covers minUniformBufferOffsetAlignment and optimalBufferCopyOffsetAlignment
+	static constexpr VkDeviceSize kAlignment = 256;
+
+	VulkanStagingRing(VulkanAllocator& allocator, uint32_t frames_in_flight,
+			VkDeviceSize capacity = kDefaultCapacity);
+	~VulkanStagingRing();
+
+	VulkanStagingRing(const VulkanStagingRing&) = delete;
+	VulkanStagingRing& operator=(const VulkanStagingRing&) = delete;
+
+	//Any thread
+	StagingAllocation Allocate(VkDeviceSize size) {
+		const VkDeviceSize aligned = (size + kAlignment - 1) & ~(kAlignment - 1);
+		const VkDeviceSize offset = head_.fetch_add(aligned, std::memory_order_relaxed);
+		if (offset + aligned <= partition_size_) [[likely]] {
+			const VkDeviceSize base = partition_base_ + offset;
+			return { ring_.buffer, base, size, static_cast<std::byte*>(ring_.GerMappedData()) + base };
+		}
+		return AllocateDedicated(size);
+	}
+
+	StagingAllocation Write(const void* data, VkDeviceSize size) {
+		StagingAllocation allocation = Allocate(size);
+		if (allocation.IsValid()) [[likely]] {
+			std::memcpy(allocation.data, data, size);
+		}
+		return allocation;
+	}
+
+	template <typename T>
+	StagingAllocation Write(const std::vector<T>& data) {
+		return Write(data.data(), sizeof(T) * data.size());
+	}
+
+	//Render thread, not concurrent with Allocate; flushes the partition being left
+	//and returns its dedicated buffers, still in use by copies not yet finished
+	[[nodiscard]] std::vector<VulkanAllocator::Buffer> BeginFrame(uint64_t serial);
+	//Makes host writes of the current partition visible; before every submit reading
+	//from the ring, including the frame's own, on non-coherent memory
+	void Flush();
+
+	VkDeviceSize PartitionSize() const noexcept { return partition_size_; }
+	uint32_t PartitionCount() const noexcept { return partition_count_; }
+	VkBuffer GetBuffer() const noexcept { return ring_.buffer; }
+
+private:
+	StagingAllocation AllocateDedicated(VkDeviceSize size);
+
+private:
+	VulkanAllocator& allocator_;
+	VulkanAllocator::Buffer ring_;
+	uint32_t partition_count_;
+	VkDeviceSize partition_size_;
+
+	uint32_t partition_ = 0;
+	VkDeviceSize partition_base_ = 0;
+	std::atomic<VkDeviceSize> head_{ 0 };
+	VkDeviceSize flushed_ = 0; //render thread
+
+	std::mutex dedicated_mutex_;
+	std::vector<VulkanAllocator::Buffer> dedicated_; //current partition
+};
+
+} //namespace Driver::Vulkan::Memory
+
+#endif
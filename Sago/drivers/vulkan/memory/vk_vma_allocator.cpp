@@ -273,16 +273,22 @@ void VulkanAllocator::DestroyMemoryPool(VmaPool pool) noexcept {
 VulkanAllocator::MemoryStats VulkanAllocator::GetMemoryStats() const {
 	MemoryStats stats = {};
 
+	const VkPhysicalDeviceMemoryProperties* properties = nullptr;
+	vmaGetMemoryProperties(allocator_, &properties);
+
 	VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
 	vmaGetHeapBudgets(allocator_, budgets);
 
-	stats.budgets.assign(budgets, budgets + VK_MAX_MEMORY_HEAPS);
+	//Only the heaps the device actually exposes
+	stats.budgets.assign(budgets, budgets + properties->memoryHeapCount);
 
 	for (const auto& budget : stats.budgets) {
-		stats.totalAllocatedBytes += budget.usage;
-		stats.usedBytes += budget.usage;
+		stats.totalAllocatedBytes += budget.statistics.blockBytes;
+		stats.usedBytes += budget.statistics.allocationBytes;
 		stats.totalAllocationCount += budget.statistics.allocationCount;
 		stats.allocationCount += budget.statistics.allocationCount;
+		stats.blockCount += budget.statistics.blockCount;
+		stats.budgetBytes += budget.budget;
 	}
 
 	return stats;
@@ -293,6 +299,7 @@ void VulkanAllocator::PrintDetailedStats(bool verbose) const {
 	LogInfoDetail("=== VMA Memory Statistics ===");
 	LogInfoDetail("Total Allocated: {} bytes", stats.totalAllocatedBytes);
 	LogInfoDetail("Total Allocations: {}", stats.totalAllocationCount);
+	LogInfoDetail("Memory Blocks: {}", stats.blockCount);
 
 	if (verbose) {
 		for (size_t i = 0; i < stats.budgets.size(); ++i) {
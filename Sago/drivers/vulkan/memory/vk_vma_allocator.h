@@ -177,6 +177,8 @@ public:
 		size_t totalAllocationCount = 0;
 		size_t usedBytes = 0;
 		size_t allocationCount = 0;
+		size_t blockCount = 0; //device memory blocks behind the allocations
+		size_t budgetBytes = 0;
 		std::vector<VmaBudget> budgets;
 	};
 
@@ -2,88 +2,193 @@
 
 #include <filesystem>
 #include <future>
+#include <system_error>
+#include <vector>
 
 #include "core/io/log/log.h"
 #include "drivers/vulkan/tools/vk_read_shaders.h"
 
 namespace Driver::Vulkan::Shader {
 
+namespace {
+
+constexpr uint32_t kSpirvMagic = 0x07230203;
+
+//FNV-1a over words, SPIR-V is always a whole number of them
+uint64_t HashCode(std::span<const uint32_t> code) noexcept {
+	uint64_t hash = 14695981039346656037ULL;
+	for (uint32_t word : code) {
+		hash = (hash ^ word) * 1099511628211ULL;
+	}
+	return hash;
+}
+
+} //namespace
+
 void VulkanShaderManager::Release(const VkDevice& device) {
-	for (auto module : shadermodules_) {
+	std::lock_guard lock(mutex_);
+	for (auto module : modules_) {
 		vkDestroyShaderModule(device, module.second, nullptr);
 	}
+	modules_.clear();
+	files_.clear();
 }
 
-VkShaderModule VulkanShaderManager::createShaderModule(const VkDevice& device, const std::vector<char>& code) {
+VkShaderModule VulkanShaderManager::createShaderModule(const VkDevice& device, std::span<const uint32_t> code) {
 	VkShaderModuleCreateInfo createInfo{};
 	createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-	createInfo.codeSize = code.size();
-	createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+	createInfo.codeSize = code.size_bytes();
+	createInfo.pCode = code.data();
 
-	VkShaderModule shaderModule;
+	VkShaderModule shaderModule = VK_NULL_HANDLE;
 	if (vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS) {
 		LogErrorDetail("[Vulkan][Shader]: Fail To Create ShaderModule: {}", shaderpath_);
 	}
 	return shaderModule;
 }
 
-VkShaderModule VulkanShaderManager::LoadShader(const VkDevice& device, std::string_view shader) {
-	namespace fs = std::filesystem;
-	fs::path fullPath = fs::path(shaderpath_) / fs::path(shader);
-	auto code = Tools::ReadShaderFile(fullPath.string());
-	auto mode = createShaderModule(device, code);
-	shadermodules_.emplace(shader, mode);
-	return mode;
+VkShaderModule VulkanShaderManager::InternModule(const VkDevice& device, uint64_t hash, std::span<const uint32_t> code) {
+	{
+		std::lock_guard lock(mutex_);
+		if (auto it = modules_.find(hash); it != modules_.end()) {
+			return it->second;
+		}
+	}
+	VkShaderModule module = createShaderModule(device, code);
+	if (!module) {
+		return VK_NULL_HANDLE;
+	}
+	std::lock_guard lock(mutex_);
+	auto [it, inserted] = modules_.try_emplace(hash, module);
+	if (!inserted) {
+		//Same code under another name finished first
+		vkDestroyShaderModule(device, module, nullptr);
+	}
+	return it->second;
 }
 
-//Corutine Async
-TaskModule VulkanShaderManager::LoadShaderModuleAsync(const VkDevice& device, std::string_view shaderName, s_callback callback) {
-	using namespace Core::Async;
+VulkanShaderManager::Loaded VulkanShaderManager::ReadModule(const VkDevice& device, std::string_view shader) {
 	namespace fs = std::filesystem;
+	const fs::path fullPath = fs::path(shaderpath_) / fs::path(shader);
+
+	Loaded loaded;
+	//With hot reload a compiler may be rewriting the file: a mapping faults once the
+	//file is truncated under it, a copy can only come out short or stale
+	Tools::MappedFile file;
+	std::vector<char> copy;
+	std::span<const uint32_t> code;
+	if (hot_reload_) {
+		std::error_code error;
+		loaded.write_time_ = fs::last_write_time(fullPath, error);
+		copy = Tools::ReadShaderFile(fullPath.string());
+		const auto size = fs::file_size(fullPath, error);
+		if (error || size != copy.size() || fs::last_write_time(fullPath, error) != loaded.write_time_) {
+			//Changed while being read, the next reload picks it up
+			return {};
+		}
+		if (copy.size() % sizeof(uint32_t) == 0) {
+			code = { reinterpret_cast<const uint32_t*>(copy.data()), copy.size() / sizeof(uint32_t) };
+		}
+	} else {
+		file = Tools::MappedFile(fullPath.string());
+		code = file.Words();
+	}
+	if (code.empty() || code.front() != kSpirvMagic) {
+		LogErrorDetail("[Vulkan][Shader]: Not A SPIR-V File: {}", shader);
+		return loaded;
+	}
+	loaded.hash_ = HashCode(code);
+	loaded.module_ = InternModule(device, loaded.hash_, code);
+	return loaded;
+}
 
-	fs::path fullPath = fs::path(shaderpath_) / fs::path(shaderName);
-	FileReader reader(fullPath.string());
-	std::vector<char> code = co_await reader;
+VkShaderModule VulkanShaderManager::LoadShader(const VkDevice& device, std::string_view shader) {
+	std::promise<VkShaderModule> promise;
+	{
+		std::unique_lock lock(mutex_);
+		if (auto it = files_.find(shader); it != files_.end()) [[likely]] {
+			return it->second.module_;
+		}
+		if (auto it = loading_.find(shader); it != loading_.end()) {
+			auto pending = it->second;
+			lock.unlock();
+			return pending.get();
+		}
+		loading_.emplace(std::string(shader), promise.get_future().share());
+	}
 
-	if (code.empty()) {
-		LogErrorDetail("Failed to load shader: {}", shaderName);
-		co_return VK_NULL_HANDLE;
+	Loaded loaded = ReadModule(device, shader);
+	{
+		std::lock_guard lock(mutex_);
+		//A failed read is not remembered, the next load tries the file again
+		if (loaded.module_) {
+			files_.emplace(std::string(shader), loaded);
+		}
+		loading_.erase(loading_.find(shader));
 	}
+	promise.set_value(loaded.module_);
+	if (loaded.module_) {
+		LogInfo("[Vulkan][Shader]: loaded successfully: {}", shader);
+	}
+	return loaded.module_;
+}
 
-	VkShaderModule module = createShaderModule(device, code);
-	shadermodules_.emplace(std::string(shaderName), module);
-	LogInfo("[Vulkan][Shader]: loaded successfully: {}", shaderName);
-	callback(module);
+std::vector<VkShaderModule> VulkanShaderManager::LoadShaders(const VkDevice& device, std::span<const std::string_view> shaders) {
+	std::vector<VkShaderModule> modules(shaders.size());
+	if (shaders.empty()) {
+		return modules;
+	}
 
-	co_return module;
+	//The calling thread takes the first name, the rest are read alongside it
+	std::vector<std::future<VkShaderModule>> pending;
+	pending.reserve(shaders.size() - 1);
+	for (size_t i = 1; i < shaders.size(); ++i) {
+		pending.push_back(std::async(std::launch::async, [this, device, shader = shaders[i]] {
+			return LoadShader(device, shader);
+		}));
+	}
+	modules[0] = LoadShader(device, shaders[0]);
+	for (size_t i = 1; i < shaders.size(); ++i) {
+		modules[i] = pending[i - 1].get();
+	}
+	return modules;
 }
 
-TaskTwoModule VulkanShaderManager::LoadShaderModuleAsync(const VkDevice& device, std::string_view vert, std::string_view frag, t_callback callback) {
-	using namespace Core::Async;
+std::vector<std::string> VulkanShaderManager::ReloadChanged(const VkDevice& device) {
 	namespace fs = std::filesystem;
+	std::vector<std::string> changed;
+	if (!hot_reload_) {
+		return changed;
+	}
 
-	fs::path vertPath = fs::path(shaderpath_) / fs::path(vert);
-	fs::path fragPath = fs::path(shaderpath_) / fs::path(frag);
-
-	//vert
-	FileReader vert_reader(vertPath.string());
-	std::vector<char> code = co_await vert_reader;
-
-	VkShaderModule module_vert = createShaderModule(device, code);
-	shadermodules_.emplace(std::string(vert), module_vert);
-	LogInfo("[Vulkan][Shader]: loaded successfully: {}", vert);
-
-	//frag
-	FileReader frag_reader(fragPath.string());
-	code.clear();
-	code = co_await frag_reader;
-
-	auto module_frag = createShaderModule(device, code);
-	shadermodules_.emplace(std::string(frag), module_frag);
-	LogInfo("[Vulkan][Shader]: loaded successfully: {}", frag);
-	callback(module_vert, module_frag);
+	std::vector<std::pair<std::string, Loaded>> known;
+	{
+		std::lock_guard lock(mutex_);
+		known.reserve(files_.size());
+		for (const auto& [name, loaded] : files_) {
+			known.emplace_back(name, loaded);
+		}
+	}
 
-	co_return { module_vert, module_frag };
+	for (auto& [name, previous] : known) {
+		std::error_code error;
+		const auto time = fs::last_write_time(fs::path(shaderpath_) / fs::path(name), error);
+		if (error || time == previous.write_time_) {
+			continue;
+		}
+		Loaded loaded = ReadModule(device, name);
+		if (!loaded.module_) {
+			//Mid-write or broken, keep the old module and retry next time
+			continue;
+		}
+		std::lock_guard lock(mutex_);
+		files_[name] = loaded;
+		if (loaded.hash_ != previous.hash_) {
+			LogInfo("[Vulkan][Shader]: reloaded: {}", name);
+			changed.push_back(name);
+		}
+	}
+	return changed;
 }
 
-} //namespace Driver::Vulkan::Shader
\ No newline at end of file
+} //namespace Driver::Vulkan::Shader
@@ -1,42 +1,82 @@
 #ifndef SG_VULKAN_SHADER_MANAGER_H
 #define SG_VULKAN_SHADER_MANAGER_H
 #include <volk.h>
+#include <cstdint>
+#include <filesystem>
 #include <functional>
+#include <future>
+#include <initializer_list>
+#include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
-#include "core/async/coroutine/task/file_read.h"
+#include "core/memory/simple_allocate.h"
 #include "drivers/vulkan/vk_device.h"
 
 namespace Driver::Vulkan::Shader {
 
-using TaskFile = Core::Async::CoroutineGenerator<std::vector<char>, Core::Async::CoroutinePolicy::Await>;
-using TaskModule = Core::Async::CoroutineGenerator<VkShaderModule, Core::Async::CoroutinePolicy::Await>;
-using TaskTwoModule = Core::Async::CoroutineGenerator<std::pair<VkShaderModule,VkShaderModule>, Core::Async::CoroutinePolicy::Await>;
+#if defined(SAGA_SHADER_HOT_RELOAD)
+inline constexpr bool kShaderHotReload = true;
+#else
+inline constexpr bool kShaderHotReload = false;
+#endif
 
+/**
+ * @brief Shader modules keyed by the hash of their SPIR-V
+ * A name is read once (mapped, not copied; copied with hot reload, where the file
+ * may change while it is read) and later loads are a map lookup; two
+ * names with identical code share one module, so pipelines keyed on modules dedupe
+ * too. Concurrent loads of the same name wait for the first instead of reading it
+ * again, and LoadShaders reads a batch in parallel. With hot reload on, ReloadChanged
+ * rebuilds only the files whose write time and content changed. Replaced modules
+ * stay alive until Release, pipelines compiling from them are unaffected.
+ */
 class VulkanShaderManager {
-
-	using s_callback = std::function<void(VkShaderModule)>;
-	using t_callback = std::function<void(VkShaderModule,VkShaderModule)>;
 public:
-	VulkanShaderManager(std::string shaderPath = "Assets/Shaders/") :
-			shaderpath_(std::move(shaderPath)) {}
+	VulkanShaderManager(std::string shaderPath = "Assets/Shaders/", bool hotReload = false) :
+			shaderpath_(std::move(shaderPath)), hot_reload_(hotReload) {}
 	~VulkanShaderManager() = default;
 public:
 	void Release(const VkDevice&);
+	//Any thread
 	VkShaderModule LoadShader(const VkDevice&, std::string_view);
+	//Any thread, in the order of the names
+	std::vector<VkShaderModule> LoadShaders(const VkDevice&, std::span<const std::string_view>);
+	std::vector<VkShaderModule> LoadShaders(const VkDevice& device, std::initializer_list<std::string_view> names) {
+		return LoadShaders(device, std::span(names.begin(), names.size()));
+	}
 
-	//Async(Coroutine)
-	TaskModule LoadShaderModuleAsync(const VkDevice&, std::string_view,s_callback = nullptr);
-	TaskTwoModule LoadShaderModuleAsync(const VkDevice&, std::string_view,std::string_view,t_callback = nullptr);
+	//Names whose module was replaced, their pipelines need a rebuild
+	std::vector<std::string> ReloadChanged(const VkDevice&);
 private:
-	VkShaderModule createShaderModule(const VkDevice&, const std::vector<char>&);
+	struct Loaded {
+		uint64_t hash_ = 0;
+		VkShaderModule module_ = VK_NULL_HANDLE;
+		std::filesystem::file_time_type write_time_{};
+	};
+	Loaded ReadModule(const VkDevice&, std::string_view);
+	VkShaderModule InternModule(const VkDevice&, uint64_t, std::span<const uint32_t>);
+	VkShaderModule createShaderModule(const VkDevice&, std::span<const uint32_t>);
 private:
 	std::string shaderpath_;
-	std::unordered_map<std::string, VkShaderModule> shadermodules_;
+	bool hot_reload_;
+
+	struct NameHash {
+		using is_transparent = void;
+		size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+	};
+	template <typename K, typename V, typename H = std::hash<K>, typename E = std::equal_to<K>>
+	using PoolMap = std::unordered_map<K, V, H, E, Core::Memory::PoolAllocator<std::pair<const K, V>>>;
+
+	std::mutex mutex_;
+	PoolMap<uint64_t, VkShaderModule> modules_; //by content hash
+	PoolMap<std::string, Loaded, NameHash, std::equal_to<>> files_;
+	PoolMap<std::string, std::shared_future<VkShaderModule>, NameHash, std::equal_to<>> loading_;
 };
 
 } //namespace Driver::Vulkan::Shader
 
-#endif
\ No newline at end of file
+#endif
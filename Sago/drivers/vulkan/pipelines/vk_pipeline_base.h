@@ -2,6 +2,8 @@
 #define SG_VK_BASE_PIPELINE_H
 
 #include <volk.h>
+#include <chrono>
+#include <future>
 #include <string_view>
 #include <type_traits>
 
@@ -13,20 +15,42 @@ template <typename ConcreteWindow>
 	requires std::is_class_v<ConcreteWindow>
 struct VulkanPipelineBase {
 public:
+	//The pipeline swapped in by the last PollPipeline, a plain read
 	VkPipeline GetPipeLine() const { return pipeline_; }
 	operator VkPipeline() const { return GetPipeLine(); }
+
+	//Render thread, before recording. Waits for the first compile. After a hot reload the
+	//previous pipeline is kept until the rebuild is done, and when the rebuild fails
+	void PollPipeline() {
+		if (pending_.valid() && (!pipeline_ || pending_.wait_for(std::chrono::seconds(0)) == std::future_status::ready)) {
+			if (const VkPipeline built = pending_.get()) {
+				pipeline_ = built;
+			}
+			pending_ = {};
+		}
+	}
+
+	//Render thread; true when a shader changed on disk and a rebuild was started
+	bool HotReloadPipeline() {
+		return static_cast<ConcreteWindow*>(this)->HotReloadPipelineImpl();
+	}
 protected:
 	void CreatePipeline() {
 		LogInfo("[Vulkan][{0}] Create {0} Pipeline", ConcreteWindow::kClassName);
 		static_cast<ConcreteWindow*>(this)->CreatePipelineImpl();
 	}
 
-	void HotReloadPipeline(std::string_view) {
+	//Recipes read the owner, it must not go away while one runs
+	void WaitPending() const {
+		if (pending_.valid()) {
+			pending_.wait();
+		}
 	}
 
 protected:
 	VkPipelineLayout pipeline_layout_{};
 	VkPipeline pipeline_{};
+	std::shared_future<VkPipeline> pending_;
 };
 
 } //namespace Driver::Vulkan
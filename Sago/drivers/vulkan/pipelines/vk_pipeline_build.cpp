@@ -1,9 +1,50 @@
 #include "vk_pipeline_build.h"
+#include <algorithm>
 #include <cstdint>
+#include <span>
+#include <type_traits>
 #include <vector>
 
 namespace Driver::Vulkan {
 
+namespace {
+
+//FNV-1a over fields rather than whole create infos, sType/pNext/padding must not split equal states
+class StateHasher {
+public:
+	template <typename T>
+		requires std::is_trivially_copyable_v<T>
+	void Add(const T& value) noexcept {
+		const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+		for (size_t i = 0; i < sizeof(T); ++i) {
+			hash_ = (hash_ ^ bytes[i]) * 1099511628211ULL;
+		}
+	}
+
+	void Add(std::string_view text) noexcept {
+		Add(text.size());
+		for (char c : text) {
+			Add(c);
+		}
+	}
+
+	//Only for arrays of padding-free Vulkan structs
+	template <typename T>
+	void AddRange(const T* values, uint32_t count) noexcept {
+		Add(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			Add(values[i]);
+		}
+	}
+
+	uint64_t Value() const noexcept { return hash_; }
+
+private:
+	uint64_t hash_ = 14695981039346656037ULL;
+};
+
+} //namespace
+
 PipelineBuilder::PipelineBuilder(const VulkanDevice& device) :
 		device_(device) {
 	shader_stages_.reserve(2);
@@ -143,7 +184,80 @@ PipelineBuilder& PipelineBuilder::SetRenderPass(VkRenderPass renderPass) {
 	return *this;
 }
 
-VkPipeline PipelineBuilder::Build() {
+uint64_t PipelineBuilder::Hash() const {
+	StateHasher hasher;
+
+	//Shaders
+	hasher.Add(static_cast<uint32_t>(shader_stages_.size()));
+	for (const auto& stage : shader_stages_) {
+		hasher.Add(stage.stage);
+		hasher.Add(stage.module);
+		hasher.Add(std::string_view(stage.pName));
+	}
+
+	//Vertex layout
+	hasher.AddRange(vertex_input_info_.pVertexBindingDescriptions, vertex_input_info_.vertexBindingDescriptionCount);
+	hasher.AddRange(vertex_input_info_.pVertexAttributeDescriptions, vertex_input_info_.vertexAttributeDescriptionCount);
+	hasher.Add(input_assembly_info_.topology);
+	hasher.Add(input_assembly_info_.primitiveRestartEnable);
+
+	//Viewport, values only count when they are baked in
+	std::span<const VkDynamicState> dynamics(dynamic_state_info_.pDynamicStates, dynamic_state_info_.dynamicStateCount);
+	hasher.AddRange(dynamics.data(), static_cast<uint32_t>(dynamics.size()));
+	hasher.Add(viewport_state_info_.viewportCount);
+	hasher.Add(viewport_state_info_.scissorCount);
+	if (std::ranges::find(dynamics, VK_DYNAMIC_STATE_VIEWPORT) == dynamics.end()) {
+		hasher.AddRange(viewport_state_info_.pViewports, viewport_state_info_.pViewports ? viewport_state_info_.viewportCount : 0);
+	}
+	if (std::ranges::find(dynamics, VK_DYNAMIC_STATE_SCISSOR) == dynamics.end()) {
+		hasher.AddRange(viewport_state_info_.pScissors, viewport_state_info_.pScissors ? viewport_state_info_.scissorCount : 0);
+	}
+
+	//Raster
+	hasher.Add(rasterization_info_.depthClampEnable);
+	hasher.Add(rasterization_info_.rasterizerDiscardEnable);
+	hasher.Add(rasterization_info_.polygonMode);
+	hasher.Add(rasterization_info_.cullMode);
+	hasher.Add(rasterization_info_.frontFace);
+	hasher.Add(rasterization_info_.depthBiasEnable);
+	hasher.Add(rasterization_info_.depthBiasConstantFactor);
+	hasher.Add(rasterization_info_.depthBiasClamp);
+	hasher.Add(rasterization_info_.depthBiasSlopeFactor);
+	hasher.Add(rasterization_info_.lineWidth);
+
+	//Multisample
+	hasher.Add(multisample_info_.rasterizationSamples);
+	hasher.Add(multisample_info_.sampleShadingEnable);
+	hasher.Add(multisample_info_.minSampleShading);
+	hasher.Add(multisample_info_.alphaToCoverageEnable);
+	hasher.Add(multisample_info_.alphaToOneEnable);
+	if (multisample_info_.pSampleMask) {
+		hasher.AddRange(multisample_info_.pSampleMask, (static_cast<uint32_t>(multisample_info_.rasterizationSamples) + 31) / 32);
+	}
+
+	//Blend
+	hasher.Add(color_blend_info_.logicOpEnable);
+	hasher.Add(color_blend_info_.logicOp);
+	hasher.AddRange(color_blend_info_.pAttachments, color_blend_info_.attachmentCount);
+	hasher.AddRange(color_blend_info_.blendConstants, 4);
+
+	//Layout and render pass; the handle stands in for compatibility. Registry layouts are
+	//shared by create info, equal passes created twice do not share
+	hasher.Add(pipeline_layout_);
+	hasher.Add(render_pass_);
+	hasher.Add(uint32_t(0)); //subpass
+	return hasher.Value();
+}
+
+uint64_t PipelineBuilder::HashLayout(const VkPipelineLayoutCreateInfo& info) {
+	StateHasher hasher;
+	hasher.Add(info.flags);
+	hasher.AddRange(info.pSetLayouts, info.pSetLayouts ? info.setLayoutCount : 0);
+	hasher.AddRange(info.pPushConstantRanges, info.pPushConstantRanges ? info.pushConstantRangeCount : 0);
+	return hasher.Value();
+}
+
+VkPipeline PipelineBuilder::Build(VkPipelineCache cache) {
 	VkGraphicsPipelineCreateInfo pipelineInfo{};
 	pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
 	pipelineInfo.stageCount = static_cast<uint32_t>(shader_stages_.size());
@@ -167,8 +281,8 @@ VkPipeline PipelineBuilder::Build() {
 	pipelineInfo.basePipelineHandle = VK_NULL_HANDLE; // Optional
 	pipelineInfo.basePipelineIndex = -1; // Optional
 
-	VkPipeline graphicsPipeline;
-	if (vkCreateGraphicsPipelines(device_, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
+	VkPipeline graphicsPipeline = VK_NULL_HANDLE;
+	if (vkCreateGraphicsPipelines(device_, cache, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
 		LogErrorDetail("[Vulkan][Pipeline]: Faile to Create Pileline");
 	}
 	return graphicsPipeline;
@@ -87,7 +87,14 @@ public:
 	PipelineBuilder& SetPipelineLayout(VkPipelineLayout layout);
 	PipelineBuilder& SetRenderPass(VkRenderPass renderPass);
 
-	VkPipeline Build();
+	//Any thread, each builder on one thread; cache may be shared
+	VkPipeline Build(VkPipelineCache cache = VK_NULL_HANDLE);
+	//Key of everything Build bakes into the pipeline, dynamic viewport and scissor values excluded.
+	//Modules, layout and render pass count by handle: take layouts from the registry so equal
+	//ones are one handle, and keep each object alive while its pipelines can be acquired
+	uint64_t Hash() const;
+	//Flags, set layouts (by handle) and push constant ranges
+	static uint64_t HashLayout(const VkPipelineLayoutCreateInfo& info);
 
 private:
 	const VulkanDevice& device_;
@@ -0,0 +1,102 @@
+#include "vk_pipeline_cache.h"
+
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <system_error>
+
+#include "core/io/log/log.h"
+
+namespace Driver::Vulkan {
+
+namespace {
+
+std::vector<char> ReadBlob(const std::filesystem::path& path) {
+	std::ifstream file(path, std::ios::ate | std::ios::binary);
+	if (!file.is_open()) {
+		return {};
+	}
+	std::vector<char> blob(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	file.read(blob.data(), static_cast<std::streamsize>(blob.size()));
+	if (!file) {
+		return {};
+	}
+	return blob;
+}
+
+} //namespace
+
+VulkanPipelineCache::VulkanPipelineCache(const VulkanDevice& device, std::filesystem::path directory) :
+		device_(device.GetDevice()) {
+	vkGetPhysicalDeviceProperties(device.GetPhysicalDevice(), &properties_);
+	path_ = directory / std::format("pipeline_{:04x}_{:04x}.bin", properties_.vendorID, properties_.deviceID);
+
+	std::vector<char> blob = ReadBlob(path_);
+	if (!blob.empty() && !IsCompatible(blob)) {
+		LogWarring("[Vulkan][PipelineCache] Discard Stale Cache: {}", path_.string());
+		blob.clear();
+	}
+
+	VkPipelineCacheCreateInfo createInfo{};
+	createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	createInfo.initialDataSize = blob.size();
+	createInfo.pInitialData = blob.empty() ? nullptr : blob.data();
+	if (vkCreatePipelineCache(device_, &createInfo, nullptr, &cache_) != VK_SUCCESS) {
+		LogErrorDetail("[Vulkan][PipelineCache] Failed To Create Pipeline Cache");
+	}
+	LogInfo("[Vulkan][PipelineCache] Loaded {} bytes", blob.size());
+}
+
+VulkanPipelineCache::~VulkanPipelineCache() {
+	if (cache_) {
+		Save();
+		vkDestroyPipelineCache(device_, cache_, nullptr);
+	}
+}
+
+bool VulkanPipelineCache::IsCompatible(const std::vector<char>& blob) const {
+	VkPipelineCacheHeaderVersionOne header{};
+	if (blob.size() < sizeof(header)) {
+		return false;
+	}
+	std::memcpy(&header, blob.data(), sizeof(header));
+	return header.headerSize >= sizeof(header) && header.headerSize <= blob.size()
+			&& header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+			&& header.vendorID == properties_.vendorID
+			&& header.deviceID == properties_.deviceID
+			&& std::memcmp(header.pipelineCacheUUID, properties_.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+bool VulkanPipelineCache::Save() const {
+	size_t size = 0;
+	if (vkGetPipelineCacheData(device_, cache_, &size, nullptr) != VK_SUCCESS || size == 0) {
+		return false;
+	}
+	std::vector<char> blob(size);
+	if (vkGetPipelineCacheData(device_, cache_, &size, blob.data()) != VK_SUCCESS) {
+		return false;
+	}
+
+	//Write beside and rename, a crash mid-write must not leave a torn blob
+	std::error_code error;
+	std::filesystem::create_directories(path_.parent_path(), error);
+	std::filesystem::path temp = path_;
+	temp += ".tmp";
+	{
+		std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+		file.write(blob.data(), static_cast<std::streamsize>(size));
+		if (!file) {
+			LogWarring("[Vulkan][PipelineCache] Failed To Write: {}", temp.string());
+			return false;
+		}
+	}
+	std::filesystem::rename(temp, path_, error);
+	if (error) {
+		LogWarring("[Vulkan][PipelineCache] Failed To Save: {}", path_.string());
+		return false;
+	}
+	return true;
+}
+
+} //namespace Driver::Vulkan
@@ -0,0 +1,44 @@
+#ifndef SG_VULKAN_PIPELINE_CACHE_H
+#define SG_VULKAN_PIPELINE_CACHE_H
+#include <volk.h>
+#include <filesystem>
+#include <vector>
+
+#include "drivers/vulkan/vk_device.h"
+
+namespace Driver::Vulkan {
+
+/**
+ * @brief VkPipelineCache persisted between runs
+ * The blob is stored per GPU (vendor and device id in the file name) and its
+ * header is checked against the running device before it is handed to the driver;
+ * a blob from another driver build (UUID) or a truncated file starts an empty cache.
+ * Saved on destruction, the handle is internally synchronized so any thread may
+ * compile with it.
+ */
+class VulkanPipelineCache {
+public:
+	explicit VulkanPipelineCache(const VulkanDevice& device, std::filesystem::path directory = "Cache/");
+	~VulkanPipelineCache();
+
+	VulkanPipelineCache(const VulkanPipelineCache&) = delete;
+	VulkanPipelineCache& operator=(const VulkanPipelineCache&) = delete;
+
+	VkPipelineCache GetHandle() const noexcept { return cache_; }
+	operator VkPipelineCache() const noexcept { return cache_; }
+
+	bool Save() const;
+
+private:
+	bool IsCompatible(const std::vector<char>& blob) const;
+
+private:
+	VkDevice device_;
+	VkPhysicalDeviceProperties properties_{};
+	std::filesystem::path path_;
+	VkPipelineCache cache_ = VK_NULL_HANDLE;
+};
+
+} //namespace Driver::Vulkan
+
+#endif
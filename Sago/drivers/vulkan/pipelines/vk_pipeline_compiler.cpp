@@ -0,0 +1,118 @@
+#include "vk_pipeline_compiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <system_error>
+#include <thread>
+
+#include "core/io/log/log.h"
+
+namespace Driver::Vulkan {
+
+namespace {
+
+//Drivers serialize part of every compile, past a few threads it stops paying off
+constexpr size_t kMaxCompileThreads = 4;
+
+size_t CompileThreads(size_t threads) {
+	if (threads == 0) {
+		const size_t hardware = std::thread::hardware_concurrency();
+		threads = hardware > 1 ? hardware - 1 : 1;
+	}
+	return std::clamp<size_t>(threads, 1, kMaxCompileThreads);
+}
+
+} //namespace
+
+VulkanPipelineCompiler::VulkanPipelineCompiler(const VulkanPipelineCache& cache,
+		std::filesystem::path manifest, size_t threads) :
+		cache_(cache), manifest_path_(std::move(manifest)),
+		pool_(CompileThreads(threads)) {
+	std::ifstream file(manifest_path_);
+	for (std::string name; std::getline(file, name);) {
+		if (!name.empty()) {
+			warm_.insert(std::move(name));
+		}
+	}
+	pool_.start();
+}
+
+VulkanPipelineCompiler::~VulkanPipelineCompiler() {
+	Wait();
+	SaveManifest();
+}
+
+VulkanPipelineCompiler::Result VulkanPipelineCompiler::Submit(const Recipe& recipe) {
+	auto task = std::make_shared<std::packaged_task<VkPipeline()>>(
+			[this, recipe] { return recipe(cache_.GetHandle()); });
+	Result result = task->get_future().share();
+	{
+		std::lock_guard lock(pending_mutex_);
+		++pending_;
+	}
+	pool_.add_task([this, task] {
+		(*task)();
+		std::lock_guard lock(pending_mutex_);
+		if (--pending_ == 0) {
+			idle_.notify_all();
+		}
+	});
+	return result;
+}
+
+VulkanPipelineCompiler::Result VulkanPipelineCompiler::Compile(Recipe recipe) {
+	return Submit(recipe);
+}
+
+void VulkanPipelineCompiler::Register(std::string name, Recipe recipe) {
+	std::lock_guard lock(mutex_);
+	auto [it, inserted] = entries_.try_emplace(std::move(name));
+	if (!inserted) {
+		LogWarring("[Vulkan][PipelineCompiler] Pipeline Already Registered: {}", it->first);
+		return;
+	}
+	it->second.recipe_ = std::move(recipe);
+	if (warm_.contains(it->first)) {
+		it->second.result_ = Submit(it->second.recipe_);
+	}
+}
+
+VulkanPipelineCompiler::Result VulkanPipelineCompiler::Request(std::string_view name) {
+	std::lock_guard lock(mutex_);
+	auto it = entries_.find(std::string(name));
+	if (it == entries_.end()) {
+		LogErrorDetail("[Vulkan][PipelineCompiler] Pipeline Not Registered: {}", name);
+		std::promise<VkPipeline> missing;
+		missing.set_value(VK_NULL_HANDLE);
+		return missing.get_future().share();
+	}
+
+	Entry& entry = it->second;
+	if (!entry.result_.valid()) {
+		entry.result_ = Submit(entry.recipe_);
+	}
+	requested_.insert(it->first);
+	return entry.result_;
+}
+
+void VulkanPipelineCompiler::Wait() {
+	std::unique_lock lock(pending_mutex_);
+	idle_.wait(lock, [this] { return pending_ == 0; });
+}
+
+bool VulkanPipelineCompiler::SaveManifest() const {
+	std::lock_guard lock(mutex_);
+	if (requested_.empty()) {
+		return false;
+	}
+	std::error_code error;
+	std::filesystem::create_directories(manifest_path_.parent_path(), error);
+	std::ofstream file(manifest_path_, std::ios::trunc);
+	for (const auto& name : requested_) {
+		file << name << '\n';
+	}
+	return static_cast<bool>(file);
+}
+
+} //namespace Driver::Vulkan
@@ -0,0 +1,79 @@
+#ifndef SG_VULKAN_PIPELINE_COMPILER_H
+#define SG_VULKAN_PIPELINE_COMPILER_H
+#include <volk.h>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "core/async/threadpool/thread_pool.h"
+#include "vk_pipeline_cache.h"
+
+namespace Driver::Vulkan {
+
+/**
+ * @brief Compiles pipelines on worker threads against the shared pipeline cache
+ * Named pipelines are registered with a recipe and claimed with Request. The names
+ * requested during a run are written to a manifest; on the next run a registered
+ * recipe whose name is in the manifest starts compiling right away, so the loading
+ * screen overlaps the compiles instead of the first frame paying for them.
+ * Recipes build through the VulkanPipelineRegistry, which owns the pipelines, so a
+ * warm-up result nobody requests is not leaked.
+ */
+class VulkanPipelineCompiler {
+public:
+	//Runs on a worker, must only touch state that outlives the compile
+	using Recipe = std::function<VkPipeline(VkPipelineCache)>;
+	using Result = std::shared_future<VkPipeline>;
+
+	VulkanPipelineCompiler(const VulkanPipelineCache& cache,
+			std::filesystem::path manifest = "Cache/pipelines.manifest", size_t threads = 0);
+	~VulkanPipelineCompiler();
+
+	VulkanPipelineCompiler(const VulkanPipelineCompiler&) = delete;
+	VulkanPipelineCompiler& operator=(const VulkanPipelineCompiler&) = delete;
+
+	//Unnamed, never warmed up
+	Result Compile(Recipe recipe);
+
+	//Starts at once when the last run requested `name`
+	void Register(std::string name, Recipe recipe);
+	//Claims the pipeline, compiling it now if warm-up has not
+	Result Request(std::string_view name);
+
+	//Blocks until nothing is compiling, for the end of a loading screen
+	void Wait();
+	bool SaveManifest() const;
+
+private:
+	Result Submit(const Recipe& recipe);
+
+private:
+	struct Entry {
+		Recipe recipe_;
+		Result result_;
+	};
+
+	const VulkanPipelineCache& cache_;
+	std::filesystem::path manifest_path_;
+
+	mutable std::mutex mutex_;
+	std::unordered_map<std::string, Entry> entries_;
+	std::unordered_set<std::string> warm_; //names from the last run
+	std::unordered_set<std::string> requested_; //names for the next run
+
+	std::mutex pending_mutex_;
+	std::condition_variable idle_;
+	size_t pending_ = 0;
+
+	Core::Memoory::ThreadPool pool_;
+};
+
+} //namespace Driver::Vulkan
+
+#endif
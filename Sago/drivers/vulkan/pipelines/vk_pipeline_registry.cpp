@@ -0,0 +1,128 @@
+#include "vk_pipeline_registry.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "core/io/log/log.h"
+
+namespace Driver::Vulkan {
+
+VulkanPipelineRegistry::VulkanPipelineRegistry(const VulkanDevice& device, const VulkanPipelineCache& cache,
+		size_t capacity) :
+		device_(device.GetDevice()), cache_(cache) {
+	capacity = std::bit_ceil((std::max)(capacity, size_t(16)));
+	mask_ = capacity - 1;
+	slots_ = std::make_unique<Slot[]>(capacity);
+}
+
+VulkanPipelineRegistry::~VulkanPipelineRegistry() {
+	for (size_t i = 0; i <= mask_; ++i) {
+		Slot& slot = slots_[i];
+		if (slot.state_.load(std::memory_order_acquire) == kReady) {
+			vkDestroyPipeline(device_, slot.pipeline_, nullptr);
+		}
+	}
+	for (auto& [key, pipeline] : overflow_) {
+		vkDestroyPipeline(device_, pipeline, nullptr);
+	}
+	for (auto& [key, layout] : layouts_) {
+		vkDestroyPipelineLayout(device_, layout, nullptr);
+	}
+}
+
+VkPipelineLayout VulkanPipelineRegistry::AcquireLayout(const VkPipelineLayoutCreateInfo& info) {
+	const uint64_t key = PipelineBuilder::HashLayout(info);
+	//Rare and cheap to create, a lock is enough
+	std::lock_guard lock(layout_mutex_);
+	if (auto it = layouts_.find(key); it != layouts_.end()) [[likely]] {
+		return it->second;
+	}
+	VkPipelineLayout layout = VK_NULL_HANDLE;
+	if (vkCreatePipelineLayout(device_, &info, nullptr, &layout) != VK_SUCCESS) [[unlikely]] {
+		LogErrorDetail("[Vulkan][PipelineRegistry] Failed To Create Pipeline Layout");
+		return VK_NULL_HANDLE;
+	}
+	layouts_.emplace(key, layout);
+	return layout;
+}
+
+VkPipeline VulkanPipelineRegistry::Find(uint64_t key) const noexcept {
+	key = Normalize(key);
+	for (size_t probe = 0, index = key & mask_; probe <= mask_; ++probe, index = (index + 1) & mask_) {
+		const Slot& slot = slots_[index];
+		const uint64_t current = slot.key_.load(std::memory_order_acquire);
+		if (current == key) {
+			return slot.state_.load(std::memory_order_acquire) == kReady ? slot.pipeline_ : VK_NULL_HANDLE;
+		}
+		if (current == 0) {
+			return VK_NULL_HANDLE;
+		}
+	}
+	//Overflow is rare, keep Find lock-free and let Acquire resolve it
+	return VK_NULL_HANDLE;
+}
+
+VkPipeline VulkanPipelineRegistry::Acquire(uint64_t key, const std::function<VkPipeline(VkPipelineCache)>& build) {
+	key = Normalize(key);
+	for (size_t probe = 0, index = key & mask_; probe <= mask_; ++probe, index = (index + 1) & mask_) {
+		Slot& slot = slots_[index];
+		uint64_t current = slot.key_.load(std::memory_order_acquire);
+		if (current == 0 && slot.key_.compare_exchange_strong(current, key, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			//Claimed, everyone else asking for this key waits on state_
+			return BuildSlot(slot, build);
+		}
+		if (current == key) [[likely]] {
+			uint8_t state = slot.state_.load(std::memory_order_acquire);
+			//The last build failed, the first caller since then retries it
+			if (state == kFailed && slot.state_.compare_exchange_strong(state, kBuilding, std::memory_order_acq_rel, std::memory_order_acquire)) {
+				return BuildSlot(slot, build);
+			}
+			if (state == kBuilding) {
+				slot.state_.wait(kBuilding, std::memory_order_acquire);
+				state = slot.state_.load(std::memory_order_acquire);
+			}
+			//Callers that waited on a failed build do not retry it themselves
+			return state == kReady ? slot.pipeline_ : VK_NULL_HANDLE;
+		}
+	}
+	return AcquireOverflow(key, build);
+}
+
+VkPipeline VulkanPipelineRegistry::BuildSlot(Slot& slot, const std::function<VkPipeline(VkPipelineCache)>& build) {
+	VkPipeline pipeline = VK_NULL_HANDLE;
+	try {
+		pipeline = build(cache_.GetHandle());
+	} catch (...) {
+		slot.state_.store(kFailed, std::memory_order_release);
+		slot.state_.notify_all();
+		throw;
+	}
+	if (!pipeline) [[unlikely]] {
+		LogWarring("[Vulkan][PipelineRegistry] Pipeline Build Failed, Retried On Next Acquire");
+		slot.state_.store(kFailed, std::memory_order_release);
+		slot.state_.notify_all();
+		return VK_NULL_HANDLE;
+	}
+	slot.pipeline_ = pipeline;
+	size_.fetch_add(1, std::memory_order_relaxed);
+	slot.state_.store(kReady, std::memory_order_release);
+	slot.state_.notify_all();
+	return pipeline;
+}
+
+VkPipeline VulkanPipelineRegistry::AcquireOverflow(uint64_t key, const std::function<VkPipeline(VkPipelineCache)>& build) {
+	std::lock_guard lock(overflow_mutex_);
+	if (auto it = overflow_.find(key); it != overflow_.end()) {
+		return it->second;
+	}
+	LogWarring("[Vulkan][PipelineRegistry] Table Full, {} Pipelines", size_.load(std::memory_order_relaxed));
+	//Only successful builds are kept, a throw or a failure leaves nothing behind
+	const VkPipeline pipeline = build(cache_.GetHandle());
+	if (pipeline) [[likely]] {
+		overflow_.emplace(key, pipeline);
+		size_.fetch_add(1, std::memory_order_relaxed);
+	}
+	return pipeline;
+}
+
+} //namespace Driver::Vulkan
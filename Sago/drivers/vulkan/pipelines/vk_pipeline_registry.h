@@ -0,0 +1,87 @@
+#ifndef SG_VULKAN_PIPELINE_REGISTRY_H
+#define SG_VULKAN_PIPELINE_REGISTRY_H
+#include <volk.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "vk_pipeline_build.h"
+#include "vk_pipeline_cache.h"
+
+namespace Driver::Vulkan {
+
+/**
+ * @brief Owns every pipeline, one per distinct PipelineBuilder::Hash
+ * Lookups probe a fixed open-addressed table with atomic loads only. The first
+ * thread to claim a key compiles it, threads asking for the same key meanwhile
+ * block on that slot instead of compiling a duplicate. A compile that fails or
+ * throws wakes them with VK_NULL_HANDLE and leaves the slot failed, the next
+ * Acquire of the key compiles again. Keys past the table's capacity go to a
+ * locked overflow map.
+ * Keys hold handles, not contents. Pipeline layouts come from AcquireLayout, one
+ * per distinct create info, and live as long as the registry. Shader modules and
+ * render passes must outlive every Acquire that can name them, or a new object
+ * reusing the handle value would be handed the old pipeline.
+ */
+class VulkanPipelineRegistry {
+public:
+	static constexpr size_t kDefaultCapacity = 1024;
+
+	VulkanPipelineRegistry(const VulkanDevice& device, const VulkanPipelineCache& cache,
+			size_t capacity = kDefaultCapacity);
+	~VulkanPipelineRegistry();
+
+	VulkanPipelineRegistry(const VulkanPipelineRegistry&) = delete;
+	VulkanPipelineRegistry& operator=(const VulkanPipelineRegistry&) = delete;
+
+	//Any thread, VK_NULL_HANDLE when absent or still compiling
+	VkPipeline Find(uint64_t key) const noexcept;
+
+	//Any thread, builds with the shared cache on a miss; exceptions from build propagate
+	VkPipeline Acquire(PipelineBuilder& builder) {
+		return Acquire(builder.Hash(), [&builder](VkPipelineCache cache) { return builder.Build(cache); });
+	}
+	VkPipeline Acquire(uint64_t key, const std::function<VkPipeline(VkPipelineCache)>& build);
+
+	//Any thread, owned by the registry; equal create infos give the same layout
+	VkPipelineLayout AcquireLayout(const VkPipelineLayoutCreateInfo& info);
+
+	size_t Size() const noexcept { return size_.load(std::memory_order_relaxed); }
+
+private:
+	enum SlotState : uint8_t {
+		kBuilding = 0, //claiming a key starts its build
+		kReady = 1,
+		kFailed = 2
+	};
+
+	struct Slot {
+		std::atomic<uint64_t> key_{ 0 }; //0 marks an unclaimed slot
+		std::atomic<uint8_t> state_{ kBuilding };
+		VkPipeline pipeline_ = VK_NULL_HANDLE; //published by kReady
+	};
+
+	static uint64_t Normalize(uint64_t key) noexcept { return key != 0 ? key : 1; }
+	VkPipeline BuildSlot(Slot& slot, const std::function<VkPipeline(VkPipelineCache)>& build);
+	VkPipeline AcquireOverflow(uint64_t key, const std::function<VkPipeline(VkPipelineCache)>& build);
+
+private:
+	VkDevice device_;
+	const VulkanPipelineCache& cache_;
+	size_t mask_;
+	std::unique_ptr<Slot[]> slots_;
+	std::atomic<size_t> size_{ 0 };
+
+	std::mutex overflow_mutex_;
+	std::unordered_map<uint64_t, VkPipeline> overflow_;
+
+	std::mutex layout_mutex_;
+	std::unordered_map<uint64_t, VkPipelineLayout> layouts_; //by PipelineBuilder::HashLayout
+};
+
+} //namespace Driver::Vulkan
+
+#endif
@@ -6,28 +6,20 @@
 
 namespace Driver::Vulkan {
 
-VulkanSimplePipeline::VulkanSimplePipeline(const VulkanDevice& device, const VulkanSwapchain& swapchain, const VulkanSimpleRenderPass& renderpass) :
-		device_(device), swapchain_(swapchain), renderpass_(renderpass) {
+VulkanSimplePipeline::VulkanSimplePipeline(const VulkanDevice& device, const VulkanSwapchain& swapchain, const VulkanSimpleRenderPass& renderpass,
+		VulkanPipelineRegistry& registry, VulkanPipelineCompiler& compiler) :
+		device_(device), swapchain_(swapchain), renderpass_(renderpass), registry_(registry), compiler_(compiler) {
 	CreatePipeline();
 }
 
 VulkanSimplePipeline::~VulkanSimplePipeline() noexcept {
 	const auto& device = GetDevice(device_);
+	//The compile still reads the shader modules; the registry owns the pipeline and layout
+	WaitPending();
 	shader_manager_.Release(device);
-	if (pipeline_) {
-		vkDestroyPipeline(device, pipeline_, nullptr);
-	}
-	if (pipeline_layout_) {
-		vkDestroyPipelineLayout(device, pipeline_layout_, nullptr);
-	}
 }
 
 void VulkanSimplePipeline::CreatePipelineImpl() {
-	//auto module = shader_manager_.LoadShaderModuleAsync(GetDevice(device_),"triangle_vert.spv","triangle_frag.spv");
-	//auto [vert,frag] = module.GetValue();
-	auto vert = shader_manager_.LoadShader(device_, "triangle_vert.spv");
-	auto frag = shader_manager_.LoadShader(device_, "triangle_frag.spv");
-
 	VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
 	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 	pipelineLayoutInfo.setLayoutCount = 0; // Optional
@@ -35,19 +27,40 @@ void VulkanSimplePipeline::CreatePipelineImpl() {
 	pipelineLayoutInfo.pushConstantRangeCount = 0; // Optional
 	pipelineLayoutInfo.pPushConstantRanges = nullptr; // Optional
 
-	if (vkCreatePipelineLayout(device_, &pipelineLayoutInfo, nullptr, &pipeline_layout_) != VK_SUCCESS) {
-		LogErrorDetail("[Vulkan][Pipeline]: Faile to Create Pileline Layout ");
-	}
+	//Shared with every pipeline of the same layout, so their keys match
+	pipeline_layout_ = registry_.AcquireLayout(pipelineLayoutInfo);
 
-	PipelineBuilder builder(device_);
-	auto vertShader = ShaderModuleInfo<ShaderStrategy::Vert>{ vert };
-	auto fragShader = ShaderModuleInfo<ShaderStrategy::Frag>{ frag };
+	//Compiles on the compiler's workers, PollPipeline waits for it on first use
+	compiler_.Register(kClassName, MakeRecipe());
+	pending_ = compiler_.Request(kClassName);
+}
 
-	builder.SetShaderModule(vertShader, fragShader)
-			.SetPipelineLayout(pipeline_layout_);
-	SetDefaultStatus(builder);
-	builder.SetRenderPass(renderpass_.GetRenderPass());
-	pipeline_ = builder.Build();
+bool VulkanSimplePipeline::HotReloadPipelineImpl() {
+	if (shader_manager_.ReloadChanged(GetDevice(device_)).empty()) [[likely]] {
+		return false;
+	}
+	//One rebuild at a time; frames keep the current pipeline until the new one lands.
+	//The old one stays with the registry, its key names the replaced modules
+	WaitPending();
+	PollPipeline();
+	pending_ = compiler_.Compile(MakeRecipe());
+	LogInfo("[Vulkan][{0}] Rebuild {0} Pipeline After Shader Reload", kClassName);
+	return true;
+}
+
+VulkanPipelineCompiler::Recipe VulkanSimplePipeline::MakeRecipe() {
+	const auto modules = shader_manager_.LoadShaders(GetDevice(device_), { "triangle_vert.spv", "triangle_frag.spv" });
+	return [this, vert = modules[0], frag = modules[1]](VkPipelineCache) {
+		PipelineBuilder builder(device_);
+		auto vertShader = ShaderModuleInfo<ShaderStrategy::Vert>{ vert };
+		auto fragShader = ShaderModuleInfo<ShaderStrategy::Frag>{ frag };
+
+		builder.SetShaderModule(vertShader, fragShader)
+				.SetPipelineLayout(pipeline_layout_);
+		SetDefaultStatus(builder);
+		builder.SetRenderPass(renderpass_.GetRenderPass());
+		return registry_.Acquire(builder);
+	};
 }
 
 void VulkanSimplePipeline::SetDefaultStatus(PipelineBuilder& builder) const {
@@ -6,6 +6,8 @@
 #include "drivers/vulkan/renderpass/vk_renderpass_simple.h"
 #include "drivers/vulkan/vk_device.h"
 #include "vk_pipeline_build.h"
+#include "vk_pipeline_compiler.h"
+#include "vk_pipeline_registry.h"
 
 #include "meta/traits/class_traits.h"
 
@@ -18,10 +20,14 @@ class VulkanSimplePipeline : public VulkanPipelineBase<VulkanSimplePipeline> {
 	DEFINE_CLASS_NAME(SimplePipeline);
 
 public:
-	VulkanSimplePipeline(const VulkanDevice&, const VulkanSwapchain&, const VulkanSimpleRenderPass&);
+	VulkanSimplePipeline(const VulkanDevice&, const VulkanSwapchain&, const VulkanSimpleRenderPass&,
+			VulkanPipelineRegistry&, VulkanPipelineCompiler&);
 	~VulkanSimplePipeline() noexcept;
 private:
 	void CreatePipelineImpl();
+	bool HotReloadPipelineImpl();
+	//Loads the shaders now, the recipe compiles with those modules
+	VulkanPipelineCompiler::Recipe MakeRecipe();
 
 private:
 	void SetDefaultStatus(PipelineBuilder& builder) const;
@@ -30,9 +36,11 @@ private:
 	const VulkanDevice& device_;
 	const VulkanSwapchain& swapchain_;
 	const VulkanSimpleRenderPass& renderpass_;
+	VulkanPipelineRegistry& registry_;
+	VulkanPipelineCompiler& compiler_;
 
 private:
-	Shader::VulkanShaderManager shader_manager_{ "Assets/Shaders/simple_pipeline/" };
+	Shader::VulkanShaderManager shader_manager_{ "Assets/Shaders/simple_pipeline/", Shader::kShaderHotReload };
 };
 
 } //namespace Driver::Vulkan
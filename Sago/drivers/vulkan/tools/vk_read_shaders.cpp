@@ -2,15 +2,27 @@
 
 #include <fstream>
 #include <future>
+#include <string>
+#include <utility>
 
 #include "core/io/log/log.h"
 
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace Driver::Vulkan::Tools {
 std::vector<char> ReadShaderFile(std::string_view filename) {
 	std::ifstream file(filename.data(), std::ios::ate | std::ios::binary);
 
 	if (!file.is_open()) {
 		LogErrorDetail("[File][Open] File Not Open! :{}",filename);
+		return {};
 	}
 
 	size_t fileSize = (size_t)file.tellg();
@@ -28,6 +40,7 @@ std::future<std::vector<char>> ReadShaderFileAsync(std::string_view filename) {
 		std::ifstream file(filename.data(), std::ios::ate | std::ios::binary);
 		if (!file.is_open()) {
 			LogErrorDetail("[File][Open] File Not Open!: {}",filename);
+			return std::vector<char>{};
 		}
 
 		size_t fileSize = file.tellg();
@@ -40,4 +53,88 @@ std::future<std::vector<char>> ReadShaderFileAsync(std::string_view filename) {
 	});
 }
 
+
+//The view outlives the handles, they are closed as soon as it exists
+MappedFile::MappedFile(std::string_view path) {
+	const std::string name(path);
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		LogErrorDetail("[File][Open] File Not Open!: {}", path);
+		return;
+	}
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		return;
+	}
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	void* data = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (mapping != nullptr) {
+		CloseHandle(mapping);
+	}
+	CloseHandle(file);
+	if (data == nullptr) {
+		return;
+	}
+	size_ = static_cast<size_t>(size.QuadPart);
+#else
+	const int file = ::open(name.c_str(), O_RDONLY | O_CLOEXEC);
+	if (file < 0) {
+		LogErrorDetail("[File][Open] File Not Open!: {}", path);
+		return;
+	}
+	struct stat status {};
+	if (::fstat(file, &status) != 0 || status.st_size == 0) {
+		::close(file);
+		return;
+	}
+	void* data = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	::close(file);
+	if (data == MAP_FAILED) {
+		return;
+	}
+	size_ = static_cast<size_t>(status.st_size);
+#endif
+	data_ = static_cast<const std::byte*>(data);
+}
+
+MappedFile::~MappedFile() {
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept :
+		data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+	if (this != &other) {
+		Close();
+		data_ = std::exchange(other.data_, nullptr);
+		size_ = std::exchange(other.size_, 0);
+	}
+	return *this;
+}
+
+std::span<const uint32_t> MappedFile::Words() const noexcept {
+	if (data_ == nullptr || size_ % sizeof(uint32_t) != 0) {
+		return {};
+	}
+	return { reinterpret_cast<const uint32_t*>(data_), size_ / sizeof(uint32_t) };
+}
+
+void MappedFile::Close() noexcept {
+	if (data_ == nullptr) {
+		return;
+	}
+#if defined(_WIN32)
+	UnmapViewOfFile(data_);
+#else
+	::munmap(const_cast<std::byte*>(data_), size_);
+#endif
+	data_ = nullptr;
+	size_ = 0;
+}
+
 } //namespace Driver::Vulkan::Tools
\ No newline at end of file
@@ -1,5 +1,8 @@
 #ifndef SG_VK_TOOLS_READ_SHADER_H
 #define SG_VK_TOOLS_READ_SHADER_H
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <string_view>
 #include <vector>
 #include <future>
@@ -8,9 +11,35 @@ namespace Driver::Vulkan::Tools {
 std::vector<char> ReadShaderFile(std::string_view);
 std::future<std::vector<char>> ReadShaderFileAsync(std::string_view);
 
+/**
+ * @brief Read-only mapping of a whole file
+ * The view is page aligned, so SPIR-V can go to vkCreateShaderModule without a copy.
+ */
+class MappedFile {
+public:
+	MappedFile() = default;
+	explicit MappedFile(std::string_view path);
+	~MappedFile();
 
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
 
+	bool IsValid() const noexcept { return data_ != nullptr; }
+	const std::byte* data() const noexcept { return data_; }
+	size_t size() const noexcept { return size_; }
+	//Empty unless the size is a whole number of words
+	std::span<const uint32_t> Words() const noexcept;
+
+private:
+	void Close() noexcept;
+
+private:
+	const std::byte* data_ = nullptr;
+	size_t size_ = 0;
+};
 
 } //namespace Driver::Vulkan::Tools
 
-#endif
\ No newline at end of file
+#endif
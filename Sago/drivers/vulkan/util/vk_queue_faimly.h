@@ -23,7 +23,17 @@ struct Presente {
 	auto operator()(const VkPhysicalDevice&,const VkSurfaceKHR&) const;
 };
 
-using QueueFamilyStrategy = std::variant<Graphy,Presente>;
+//Transfer-only family (DMA engine) if present, else any non-graphics transfer family
+struct Transfer {
+	auto operator()(const VkPhysicalDevice&) const;
+};
+
+//Compute family without graphics, for async compute
+struct Compute {
+	auto operator()(const VkPhysicalDevice&) const;
+};
+
+using QueueFamilyStrategy = std::variant<Graphy, Presente, Transfer, Compute>;
 
 
 QueueFamilyIndice FindIndice(const QueueFamilyStrategy&, 
@@ -52,6 +52,48 @@ auto Presente::operator()(const VkPhysicalDevice& device, const VkSurfaceKHR& su
 	return indices;
 }
 
+auto Transfer::operator()(const VkPhysicalDevice& device) const {
+	QueueFamilyIndice indices;
+	uint32_t queue_family_Count = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(device, &queue_family_Count, nullptr);
+
+	std::vector<VkQueueFamilyProperties> queueFamilies(queue_family_Count);
+	vkGetPhysicalDeviceQueueFamilyProperties(device, &queue_family_Count, queueFamilies.data());
+
+	for (uint32_t i = 0; i < queue_family_Count; ++i) {
+		const auto flags = queueFamilies[i].queueFlags;
+		if (!(flags & VK_QUEUE_TRANSFER_BIT) || (flags & VK_QUEUE_GRAPHICS_BIT)) {
+			continue;
+		}
+		if (!(flags & VK_QUEUE_COMPUTE_BIT)) {
+			indices.family_ = i;
+			break;
+		}
+		if (!indices.isComplete()) {
+			indices.family_ = i;
+		}
+	}
+	return indices;
+}
+
+auto Compute::operator()(const VkPhysicalDevice& device) const {
+	QueueFamilyIndice indices;
+	uint32_t queue_family_Count = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(device, &queue_family_Count, nullptr);
+
+	std::vector<VkQueueFamilyProperties> queueFamilies(queue_family_Count);
+	vkGetPhysicalDeviceQueueFamilyProperties(device, &queue_family_Count, queueFamilies.data());
+
+	for (uint32_t i = 0; i < queue_family_Count; ++i) {
+		const auto flags = queueFamilies[i].queueFlags;
+		if ((flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT)) {
+			indices.family_ = i;
+			break;
+		}
+	}
+	return indices;
+}
+
 QueueFamilyIndice FindIndice(const QueueFamilyStrategy& strategy,
 		const VkPhysicalDevice& device, const VkSurfaceKHR& surface) {
 	return std::visit(
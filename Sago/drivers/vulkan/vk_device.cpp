@@ -27,10 +27,18 @@ VulkanDevice::VulkanDevice(const VulkanInitializer& vulkanins, const VulkanSurfa
 void VulkanDevice::CreateLogicalDevice() {
 	auto indice_graphy = FindIndice(Graphy{}, vulkanins_);
 	auto indice_present = FindIndice(Presente{}, vulkanins_, surface_);
+	auto indice_transfer = FindIndice(Transfer{}, vulkanins_);
+	auto indice_compute = FindIndice(Compute{}, vulkanins_);
+
+	graphics_family_ = indice_graphy.family_.value();
+	transfer_family_ = indice_transfer.family_.value_or(graphics_family_);
+	compute_family_ = indice_compute.family_.value_or(graphics_family_);
 
 	std::set<uint32_t> unique_queue_familes = {
-		indice_graphy.family_.value(),
-		indice_present.family_.value()
+		graphics_family_,
+		indice_present.family_.value(),
+		transfer_family_,
+		compute_family_
 	};
 
 	std::vector<VkDeviceQueueCreateInfo> queue_create_infos;
@@ -79,6 +87,11 @@ void VulkanDevice::CreateLogicalDevice() {
 
 	VkPhysicalDeviceFeatures device_features{};
 
+	//Upload handoff and frame pacing
+	VkPhysicalDeviceVulkan12Features vulkan12_features = {};
+	vulkan12_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+	vulkan12_features.timelineSemaphore = VK_TRUE;
+
 	VkDeviceCreateInfo create_info{};
 	create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 	create_info.pQueueCreateInfos = queue_create_infos.data();
@@ -87,12 +100,18 @@ void VulkanDevice::CreateLogicalDevice() {
 	create_info.enabledExtensionCount = static_cast<uint32_t>(device_extensions.size());
 	create_info.ppEnabledExtensionNames = device_extensions.data();
 	//create_info.pNext = &device_features2;
+	create_info.pNext = &vulkan12_features;
 
 	if (auto result = vkCreateDevice(vulkanins_, &create_info, nullptr, &device_); result != VK_SUCCESS) {
 		VK_LOG_ERROR("[Vulkan][Init] Create Device: ", result);
 	}
-	vkGetDeviceQueue(device_, indice_graphy.family_.value(), 0, &graphics_queue_);
+	vkGetDeviceQueue(device_, graphics_family_, 0, &graphics_queue_);
 	vkGetDeviceQueue(device_, indice_present.family_.value(), 0, &present_queue_);
+	//A shared family shares its queue, submissions stay on the render thread
+	vkGetDeviceQueue(device_, transfer_family_, 0, &transfer_queue_);
+	vkGetDeviceQueue(device_, compute_family_, 0, &compute_queue_);
+	LogInfo("[Vulkan][Init] Queue Family Graphics {} Transfer {} Compute {}",
+			graphics_family_, transfer_family_, compute_family_);
 
 	//Only One Device
 	volkLoadDevice(device_);
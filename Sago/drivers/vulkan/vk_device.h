@@ -18,8 +18,18 @@ public:
 	VulkanDevice& operator=(VulkanDevice&&) = delete;
 
 	VkDevice GetDevice() const { return device_; }
+	VkPhysicalDevice GetPhysicalDevice() const { return vulkanins_.GetPhysicalDevice(); }
 	VkQueue GetGraphyciQueue() const { return graphics_queue_; }
 	VkQueue GetPresentQueue() const { return present_queue_; }
+	//Fall back to the graphics queue when the device has no such family
+	VkQueue GetTransferQueue() const { return transfer_queue_; }
+	VkQueue GetComputeQueue() const { return compute_queue_; }
+
+	uint32_t GetGraphicsFamily() const { return graphics_family_; }
+	uint32_t GetTransferFamily() const { return transfer_family_; }
+	uint32_t GetComputeFamily() const { return compute_family_; }
+	bool HasDedicatedTransfer() const { return transfer_family_ != graphics_family_; }
+	bool HasAsyncCompute() const { return compute_family_ != graphics_family_; }
 
 	operator VkDevice() const {return device_;}
 
@@ -35,6 +45,11 @@ private:
 	VkDevice device_{};
 	VkQueue graphics_queue_{};
 	VkQueue present_queue_{};
+	VkQueue transfer_queue_{};
+	VkQueue compute_queue_{};
+	uint32_t graphics_family_{};
+	uint32_t transfer_family_{};
+	uint32_t compute_family_{};
 };
 
 VkDevice GetDevice(const VulkanDevice&);
@@ -6,9 +6,8 @@
 
 namespace Driver::Vulkan {
 
-#define VK_LOG_LAYER_INFO(...)                                     \
-	Core::Log::PrintLogFormat<Core::Log::LogRank::kVulkanLayer>( \
-			__VA_ARGS__)
+#define VK_LOG_LAYER_INFO(...) \
+	SG_LOG_WRITE(Core::Log::LogRank::kVulkanLayer, Core::Log::LogPolicy::kSimple, Core::Log::LogCategory::kVulkan, __VA_ARGS__)
 
 #define VK_LOG_ERROR(str, result) \
 	LogErrorDetail("{} : {}", str, string_VkResult(result))
@@ -1,6 +1,7 @@
 #ifndef SG_ECS_SPARSESET_H
 #define SG_ECS_SPARSESET_H
 #include "entity.h"
+#include "core/memory/tracking/memory_tracker.h"
 
 #include <memory>
 #include <vector>
@@ -80,7 +81,7 @@ template <typename Type, typename Entity = entity>
 class basic_storage {
 private:
 	basic_sparse_set<Entity> sparse_set_;
-	std::vector<Type> components_;
+	std::vector<Type, Core::Memory::TrackedAllocator<Type, Core::Memory::MemoryTag::kECS>> components_;
 
 public:
 	using value_type = Type;
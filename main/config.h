@@ -1,7 +1,10 @@
 #ifndef SG_CONFIG_H
 #define SG_CONFIG_H
 
-#define LOG_ACTIVE_LEVEL SGLOG_LEVEL_ERROR
+//Log level comes from SAGA_LOG_LEVEL (Sago/CMakeLists.txt)
+#if !defined(LOG_ACTIVE_LEVEL)
+	#define LOG_ACTIVE_LEVEL SGLOG_LEVEL_ERROR
+#endif
 
 
 
@@ -5,6 +5,11 @@
 #include <SDL3/SDL_main.h>
 #include "context/engine_context.h"
 #include "core/events/event_system.h"
+#include "core/events/input_recorder.h"
+#include "core/io/log/log_sink.h"
+
+#include <memory>
+#include <string_view>
 
 /**
  * @brief
@@ -18,6 +23,24 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char* argv[]) {
 	if (!runtime.Init()){
 		return SDL_APP_FAILURE;
 	}
+	//Input: --record-input <file> | --replay-input <file>
+	//Log: --log-file <base path>, binary, decode with SagaLogDecoder
+	auto& recorder = Core::Event::InputRecorder::Instance();
+	for (int i = 1; i + 1 < argc; ++i) {
+		const std::string_view arg = argv[i];
+		if (arg == "--record-input") {
+			recorder.StartRecording(argv[++i]);
+		} else if (arg == "--replay-input") {
+			recorder.StartReplay(argv[++i]);
+		} else if (arg == "--log-file") {
+			auto sink = std::make_unique<Core::Log::MappedFileSink>(argv[++i]);
+			if (sink->IsOpen()) {
+				Core::Log::AsyncLog::Instance().AddSink(std::move(sink));
+			} else {
+				LogWarring("[Main] Could not open log file {}, logging to the console only", argv[i]);
+			}
+		}
+	}
     return SDL_APP_CONTINUE;
 }
 
@@ -27,6 +50,9 @@ SDL_AppResult SDL_AppEvent(void* appstate, SDL_Event* event) {
 		return SDL_APP_SUCCESS;
 	}
 	using namespace Core::Event;
+	if (!InputRecorder::Instance().Capture(*event)) {
+		return SDL_APP_CONTINUE;
+	}
 	auto& Engine = Context::EngineContext::Instance();
 	Engine.PushEvent(*event);
 	EventSystem::Instance().PublishSDLEvent<ThreadCategory::Main>(*event);
@@ -47,6 +73,7 @@ SDL_AppResult SDL_AppIterate(void* appstate) {
 //Quit
 void SDL_AppQuit(void* appstate, SDL_AppResult result) {
 	auto& runtime = Runtime::Instance();
+	Core::Event::InputRecorder::Instance().Stop();
 	runtime.Quit();
 }
 
@@ -1,9 +1,21 @@
 #include "runtime.h"
 
 #include "context/engine_context.h"
+#include "core/events/event_system.h"
+#include "core/events/input_recorder.h"
+#include "core/memory/arena/frame_arena.h"
 
 #include <atomic>
 
+namespace {
+//Replay: same path as SDL_AppEvent
+void InjectInputEvent(const SDL_Event& event) {
+	using namespace Core::Event;
+	Context::EngineContext::Instance().PushEvent(event);
+	EventSystem::Instance().PublishSDLEvent<ThreadCategory::Main>(event);
+}
+} //namespace
+
 bool Runtime::Init() {
 	runing_ = true;
 	atomic_runing_.store(true, std::memory_order_release);
@@ -13,6 +25,8 @@ bool Runtime::Init() {
 void Runtime::Tick() {
 	auto& Engine = Context::EngineContext::Instance();
 	Engine.StartFrame();
+	Core::Memory::FrameArena::ThreadLocal().Reset();
+	Core::Event::InputRecorder::Instance().BeginFrame(&InjectInputEvent);
 	
 	Context::EngineContext::Instance().Tick();
 
@@ -0,0 +1,84 @@
+#include "core/io/log/log.h"
+#include "core/io/log/log_sink.h"
+#include "saga_test.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+//ns per LogInfo call seen by the caller, 1 to 16 threads logging at once. The log
+//thread formats into a sink that only counts, so the numbers are the producer side
+using namespace Core::Log;
+
+namespace {
+
+class CountingSink : public LogSink {
+public:
+	//Only the bench's own records, not the logger's drop notices
+	void Write(const LogEntry& entry) override {
+		if (entry.text_.starts_with("frame ")) {
+			written_.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	uint64_t Written() const noexcept { return written_.load(std::memory_order_relaxed); }
+
+private:
+	std::atomic<uint64_t> written_{ 0 };
+};
+
+constexpr uint64_t kCallsPerThread = 200'000;
+
+double Run(uint32_t threads) {
+	std::atomic<bool> go{ false };
+	std::vector<double> per_thread(threads);
+	std::vector<std::thread> workers;
+	for (uint32_t t = 0; t < threads; ++t) {
+		workers.emplace_back([&, t] {
+			while (!go.load(std::memory_order_acquire)) {
+				std::this_thread::yield();
+			}
+			per_thread[t] = SagaTest::NsPerOp(kCallsPerThread, [&](uint64_t i) {
+				LogInfo("frame {} thread {} took {} ms on {}", i, t, 16.6, "bench");
+			});
+		});
+	}
+	go.store(true, std::memory_order_release);
+	for (auto& worker : workers) {
+		worker.join();
+	}
+	double total = 0;
+	for (double ns : per_thread) {
+		total += ns;
+	}
+	return total / threads;
+}
+
+} //namespace
+
+int main() {
+	auto& log = AsyncLog::Instance();
+	log.ClearSinks();
+	auto sink = std::make_unique<CountingSink>();
+	CountingSink* counter = sink.get();
+	log.AddSink(std::move(sink));
+
+	std::printf("%-8s %-8s %12s %12s\n", "policy", "threads", "ns/call", "dropped");
+	for (LogOverflow policy : { LogOverflow::kDrop, LogOverflow::kBlock }) {
+		log.SetOverflowPolicy(policy);
+		for (uint32_t threads : { 1u, 2u, 4u, 8u, 16u }) {
+			const uint64_t before = counter->Written();
+			const double ns = Run(threads);
+			//Let the log thread catch up before counting what arrived
+			for (uint64_t seen = ~uint64_t(0); seen != counter->Written();) {
+				seen = counter->Written();
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			}
+			const uint64_t dropped = kCallsPerThread * threads - (counter->Written() - before);
+			std::printf("%-8s %-8u %12.2f %12llu\n", policy == LogOverflow::kDrop ? "drop" : "block",
+					threads, ns, (unsigned long long)dropped);
+		}
+	}
+	return 0;
+}
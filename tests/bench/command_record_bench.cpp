@@ -0,0 +1,138 @@
+#include "drivers/vulkan/commands/vk_commandbuild.h"
+#include "saga_test.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+//Per-draw cost of CommandBuilder and the heap allocations it makes, which must be
+//zero. The vkCmd* entry points are volk's function pointers, swapped for stubs
+//that only count calls, so no device is needed and only the builder is measured
+using namespace Driver::Vulkan;
+
+namespace {
+std::atomic<size_t> g_allocations{ 0 };
+
+void* CountedAlloc(size_t bytes, size_t alignment) {
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	alignment = alignment < sizeof(void*) ? sizeof(void*) : alignment;
+	bytes = (bytes + alignment - 1) & ~(alignment - 1);
+	if (void* ptr = std::aligned_alloc(alignment, bytes == 0 ? alignment : bytes)) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+} //namespace
+
+void* operator new(size_t bytes) { return CountedAlloc(bytes, alignof(std::max_align_t)); }
+void* operator new[](size_t bytes) { return CountedAlloc(bytes, alignof(std::max_align_t)); }
+void* operator new(size_t bytes, std::align_val_t align) { return CountedAlloc(bytes, size_t(align)); }
+void* operator new[](size_t bytes, std::align_val_t align) { return CountedAlloc(bytes, size_t(align)); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+
+namespace {
+
+uint64_t g_commands = 0;
+
+void InstallStubs() {
+	vkCmdBindPipeline = [](VkCommandBuffer, VkPipelineBindPoint, VkPipeline) { ++g_commands; };
+	vkCmdSetViewport = [](VkCommandBuffer, uint32_t, uint32_t, const VkViewport*) { ++g_commands; };
+	vkCmdSetScissor = [](VkCommandBuffer, uint32_t, uint32_t, const VkRect2D*) { ++g_commands; };
+	vkCmdBindVertexBuffers = [](VkCommandBuffer, uint32_t, uint32_t, const VkBuffer*, const VkDeviceSize*) { ++g_commands; };
+	vkCmdBindIndexBuffer = [](VkCommandBuffer, VkBuffer, VkDeviceSize, VkIndexType) { ++g_commands; };
+	vkCmdBindDescriptorSets = [](VkCommandBuffer, VkPipelineBindPoint, VkPipelineLayout, uint32_t,
+									  uint32_t, const VkDescriptorSet*, uint32_t, const uint32_t*) { ++g_commands; };
+	vkCmdPushConstants = [](VkCommandBuffer, VkPipelineLayout, VkShaderStageFlags, uint32_t, uint32_t, const void*) { ++g_commands; };
+	vkCmdDrawIndexed = [](VkCommandBuffer, uint32_t, uint32_t, uint32_t, int32_t, uint32_t) { ++g_commands; };
+	vkCmdPipelineBarrier = [](VkCommandBuffer, VkPipelineStageFlags, VkPipelineStageFlags, VkDependencyFlags,
+								   uint32_t, const VkMemoryBarrier*, uint32_t, const VkBufferMemoryBarrier*,
+								   uint32_t, const VkImageMemoryBarrier*) { ++g_commands; };
+}
+
+//Fake handles, the stubs never look at them
+template <typename Handle>
+Handle FakeHandle(uint64_t value) {
+	return reinterpret_cast<Handle>(static_cast<uintptr_t>(value));
+}
+
+struct DrawItem {
+	VkBuffer vertex_buffer_;
+	VkBuffer index_buffer_;
+	VkDescriptorSet set_;
+	uint32_t index_count_;
+};
+
+struct PushData {
+	float transform_[16];
+};
+
+//The recording loop of VulkanContext::RendererCommand plus a descriptor set and push constants per draw
+void Record(VkCommandBuffer commandBuffer, std::span<const DrawItem> draws, uint32_t pipelines) {
+	const VkExtent2D extent{ 1280, 720 };
+	const VkPipelineLayout layout = FakeHandle<VkPipelineLayout>(0x100);
+	const PushData push{};
+	CommandBuilder builder(commandBuffer, true);
+	builder.SetViewport(extent).SetScissor(extent);
+	for (size_t i = 0; i < draws.size(); ++i) {
+		const auto& draw = draws[i];
+		builder.BindGraphicsPipeline(FakeHandle<VkPipeline>(0x200 + i % pipelines))
+				.BindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, { draw.set_ }, { 0u })
+				.PushConstants(layout, VK_SHADER_STAGE_VERTEX_BIT, 0, push)
+				.BindVertexBuffers(0, { draw.vertex_buffer_ }, { 0 })
+				.BindIndexBuffer(draw.index_buffer_, 0, VK_INDEX_TYPE_UINT16)
+				.DrawIndexed(draw.index_count_);
+	}
+	VkMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	builder.PipelineBarrier(VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, { barrier });
+}
+
+bool Run(size_t drawCount, uint32_t pipelines) {
+	constexpr uint64_t kFrames = 200;
+	std::vector<DrawItem> draws(drawCount);
+	for (size_t i = 0; i < drawCount; ++i) {
+		draws[i] = { FakeHandle<VkBuffer>(0x1000 + i), FakeHandle<VkBuffer>(0x2000 + i),
+			FakeHandle<VkDescriptorSet>(0x3000 + i), 36 };
+	}
+	const VkCommandBuffer commandBuffer = FakeHandle<VkCommandBuffer>(0x10);
+
+	Record(commandBuffer, draws, pipelines); //warm up
+	const size_t before = g_allocations.load(std::memory_order_relaxed);
+	const double ns = SagaTest::NsPerOp(kFrames, [&](uint64_t) {
+		Record(commandBuffer, draws, pipelines);
+	});
+	const size_t allocations = g_allocations.load(std::memory_order_relaxed) - before;
+	SagaTest::DoNotOptimize(g_commands);
+
+	std::printf("%-8zu %-10u %12.2f %14.3f\n", drawCount, pipelines,
+			ns / static_cast<double>(drawCount),
+			static_cast<double>(allocations) / static_cast<double>(kFrames * drawCount));
+	return allocations == 0;
+}
+
+} //namespace
+
+int main() {
+	InstallStubs();
+	std::printf("%-8s %-10s %12s %14s\n", "draws", "pipelines", "ns/draw", "allocs/draw");
+	bool clean = true;
+	for (size_t draws : { 64u, 1024u, 16384u }) {
+		for (uint32_t pipelines : { 1u, 8u }) {
+			clean &= Run(draws, pipelines);
+		}
+	}
+	if (!clean) {
+		std::printf("recording allocated\n");
+	}
+	return clean ? 0 : 1;
+}
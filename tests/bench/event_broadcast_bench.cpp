@@ -0,0 +1,66 @@
+#include "core/events/event_bus.h"
+#include "saga_test.h"
+
+#include <memory>
+#include <utility>
+
+//Broadcast cost against the number of dispatchers taking the event and the
+//handlers each runs. One thread broadcasts a batch, then drains every dispatcher
+using namespace Core::Event;
+
+namespace {
+
+struct BenchEvent {
+	uint64_t id_;
+	float payload_[14];
+};
+
+using BenchDispatcher = EventDispatcher<BenchEvent>;
+
+template <size_t... I>
+using BenchBus = EventBus<DispatcherBinding<static_cast<ThreadCategory>(I), BenchDispatcher>...>;
+
+constexpr size_t kBatch = 128; //below the ring size, nothing is dropped
+constexpr size_t kEvents = 1 << 20;
+
+template <size_t... I>
+void Run(std::index_sequence<I...>, uint32_t handlers) {
+	constexpr size_t kDispatchers = sizeof...(I);
+	auto bus = std::make_unique<BenchBus<I...>>();
+	uint64_t seen = 0;
+	auto subscribe = [&](BenchDispatcher& dispatcher) {
+		for (uint32_t h = 0; h < handlers; ++h) {
+			dispatcher.subscribe<BenchEvent>([&seen](const BenchEvent& event) { seen += event.id_; });
+		}
+	};
+	(subscribe(bus->template Get<static_cast<ThreadCategory>(I)>()), ...);
+
+	uint64_t delivered = 0;
+	double broadcast = 0;
+	double drain = 0;
+	for (size_t done = 0; done < kEvents; done += kBatch) {
+		broadcast += SagaTest::NsPerOp(kBatch, [&](uint64_t i) {
+			delivered += bus->Broadcast(BenchEvent{ done + i, {} });
+		}) * kBatch;
+		drain += SagaTest::NsPerOp(1, [&](uint64_t) {
+			(bus->template Get<static_cast<ThreadCategory>(I)>().processAllEvents(), ...);
+		});
+	}
+	SagaTest::DoNotOptimize(seen);
+	std::printf("%-12zu %-10u %14.2f %14.2f %10s\n", kDispatchers, handlers,
+			broadcast / kEvents, drain / kEvents,
+			delivered == kEvents * kDispatchers ? "ok" : "DROPPED");
+}
+
+} //namespace
+
+int main() {
+	std::printf("%-12s %-10s %14s %14s %10s\n", "dispatchers", "handlers", "broadcast ns", "drain ns", "delivery");
+	for (uint32_t handlers : { 1u, 4u, 16u }) {
+		Run(std::make_index_sequence<1>{}, handlers);
+		Run(std::make_index_sequence<2>{}, handlers);
+		Run(std::make_index_sequence<4>{}, handlers);
+		Run(std::make_index_sequence<8>{}, handlers);
+	}
+	return 0;
+}
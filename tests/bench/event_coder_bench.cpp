@@ -0,0 +1,104 @@
+#include "core/events/event_dispatcher.h"
+#include "core/events/input_recorder.h"
+#include "saga_test.h"
+
+#include <cstring>
+#include <memory>
+#include <variant>
+#include <vector>
+
+//event_coder_bench [input.sgir]: replays a recording made with InputRecorder, or a
+//synthetic stream with the same mix (mostly motion) when no file is given
+using namespace Core::Event;
+
+namespace {
+
+using InputEncoder = EventCoder<std::variant<WindowResizeEvent, WindowMinimizeEvent,
+		KeyEvent, MouseMotionEvent, MouseButtonEvent>>;
+
+std::vector<SDL_Event> g_stream;
+
+void Collect(const SDL_Event& event) {
+	g_stream.push_back(event);
+}
+
+bool LoadRecording(const char* path) {
+	auto& recorder = InputRecorder::Instance();
+	if (!recorder.StartReplay(path)) {
+		return false;
+	}
+	while (!recorder.IsReplayFinished()) {
+		recorder.BeginFrame(&Collect);
+	}
+	recorder.Stop();
+	return true;
+}
+
+void SynthesizeStream(size_t count) {
+	g_stream.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		SDL_Event event;
+		std::memset(&event, 0, sizeof(event));
+		const size_t kind = i % 20;
+		if (kind < 14) {
+			event.type = SDL_EVENT_MOUSE_MOTION;
+			event.motion.x = float(i % 1920);
+			event.motion.y = float(i % 1080);
+			event.motion.xrel = 1.0f;
+			event.motion.yrel = -1.0f;
+		} else if (kind < 17) {
+			event.type = (i & 1) ? SDL_EVENT_KEY_UP : SDL_EVENT_KEY_DOWN;
+			event.key.key = 'w';
+		} else if (kind < 19) {
+			event.type = (i & 1) ? SDL_EVENT_MOUSE_BUTTON_UP : SDL_EVENT_MOUSE_BUTTON_DOWN;
+			event.button.button = SDL_BUTTON_LEFT;
+		} else {
+			event.type = SDL_EVENT_WINDOW_RESIZED;
+			event.window.data1 = 1280;
+			event.window.data2 = 720;
+		}
+		event.common.timestamp = i;
+		g_stream.push_back(event);
+	}
+}
+
+} //namespace
+
+int main(int argc, char** argv) {
+	if (argc > 1 && !LoadRecording(argv[1])) {
+		std::printf("could not load %s\n", argv[1]);
+		return 1;
+	}
+	if (g_stream.empty()) {
+		SynthesizeStream(1'000'000);
+	}
+	std::printf("%zu events %s\n", g_stream.size(), argc > 1 ? argv[1] : "(synthetic)");
+
+	//Encode only: SDL_Event -> engine event, sink does nothing but count
+	uint64_t encoded = 0;
+	const double encode = SagaTest::NsPerOp(g_stream.size(), [&](uint64_t i) {
+		encoded += InputEncoder::encode(g_stream[i], [](auto&& event) {
+			SagaTest::DoNotOptimize(event);
+			return true;
+		});
+	});
+
+	//The main thread's path: publishSDL per event, drained once per 256 like a frame
+	auto dispatcher = std::make_unique<GameEventDispatcher>();
+	uint64_t handled = 0;
+	dispatcher->subscribe<KeyEvent>([&](const KeyEvent&) { ++handled; });
+	dispatcher->subscribe<MouseMotionEvent>([&](const MouseMotionEvent&) { ++handled; });
+	dispatcher->subscribe<MouseButtonEvent>([&](const MouseButtonEvent&) { ++handled; });
+	dispatcher->subscribe<WindowResizeEvent>([&](const WindowResizeEvent&) { ++handled; });
+	const double publish = SagaTest::NsPerOp(g_stream.size(), [&](uint64_t i) {
+		dispatcher->publishSDL(g_stream[i]);
+		if ((i & 255) == 255) {
+			dispatcher->processAllEvents();
+		}
+	});
+	dispatcher->processAllEvents();
+
+	std::printf("%-28s %10.2f ns/event (%llu encoded)\n", "encode", encode, (unsigned long long)encoded);
+	std::printf("%-28s %10.2f ns/event (%llu handled)\n", "publishSDL + drain", publish, (unsigned long long)handled);
+	return 0;
+}
@@ -0,0 +1,63 @@
+#include "core/memory/lockfree/MPSC/ring.h"
+#include "saga_test.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using Core::Memory::LockFreeMpscRing;
+
+namespace {
+
+//Producers push flat out, the consumer drains in budgets like processUpTo
+double EventsPerSecond(uint32_t producers, uint64_t per_producer) {
+	auto ring = std::make_unique<LockFreeMpscRing<uint64_t, 4096>>();
+	std::atomic<bool> go{ false };
+	std::vector<std::thread> threads;
+	for (uint32_t p = 0; p < producers; ++p) {
+		threads.emplace_back([&] {
+			while (!go.load(std::memory_order_acquire)) {
+				std::this_thread::yield();
+			}
+			for (uint64_t i = 0; i < per_producer;) {
+				if (ring->push(i)) {
+					++i;
+				} else {
+					std::this_thread::yield(); //full, let the consumer run
+				}
+			}
+		});
+	}
+
+	const uint64_t total = per_producer * producers;
+	uint64_t received = 0;
+	uint64_t sum = 0;
+	const auto start = std::chrono::steady_clock::now();
+	go.store(true, std::memory_order_release);
+	while (received < total) {
+		const size_t taken = ring->consume([&](uint64_t value) { sum += value; }, 256);
+		received += taken;
+		if (taken == 0) {
+			std::this_thread::yield();
+		}
+	}
+	const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	SagaTest::DoNotOptimize(sum);
+	return double(total) / elapsed;
+}
+
+} //namespace
+
+int main() {
+	std::printf("%-10s %14s %14s\n", "producers", "Mevents/s", "ns/event");
+	for (uint32_t producers : { 1u, 2u, 4u, 8u, 16u }) {
+		const double rate = EventsPerSecond(producers, 4'000'000 / producers);
+		std::printf("%-10u %14.2f %14.2f\n", producers, rate / 1e6, 1e9 / rate);
+	}
+	return 0;
+}
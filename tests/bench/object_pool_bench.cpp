@@ -0,0 +1,70 @@
+#include "core/memory/pool/free_list.h"
+#include "saga_test.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using Core::Memory::ObjectPool;
+
+namespace {
+
+struct Particle {
+	float position_[3];
+	float velocity_[3];
+	uint32_t flags_;
+};
+
+constexpr uint64_t kIterations = 2'000'000;
+constexpr size_t kBatch = 256;
+
+template <typename New, typename Delete>
+double Churn(New&& make, Delete&& destroy) {
+	std::vector<Particle*> batch(kBatch);
+	return SagaTest::NsPerOp(kIterations / kBatch, [&](uint64_t) {
+		for (auto& p : batch) {
+			p = make();
+		}
+		SagaTest::DoNotOptimize(batch.data());
+		for (auto* p : batch) {
+			destroy(p);
+		}
+	}) / kBatch;
+}
+
+} //namespace
+
+int main() {
+	std::printf("%-28s %10s\n", "case", "ns/op");
+
+	{
+		ObjectPool<Particle> pool;
+		const double ns = Churn([&] { return pool.New(); }, [&](Particle* p) { pool.Delete(p); });
+		std::printf("%-28s %10.2f\n", "ObjectPool new+delete", ns);
+	}
+	{
+		const double ns = Churn([] { return new Particle(); }, [](Particle* p) { delete p; });
+		std::printf("%-28s %10.2f\n", "operator new+delete", ns);
+	}
+	{
+		//Huge pages only help once the pool spans many pages
+		ObjectPool<Particle, 16384> pool(Core::Memory::PagePolicy::kTransparentHuge);
+		const double ns = Churn([&] { return pool.New(); }, [&](Particle* p) { pool.Delete(p); });
+		std::printf("%-28s %10.2f\n", "ObjectPool THP", ns);
+	}
+	{
+		//Producer allocates, consumer frees: every delete takes the remote path
+		ObjectPool<Particle> pool;
+		constexpr size_t kCount = 1'000'000;
+		std::vector<Particle*> items(kCount);
+		const double alloc = SagaTest::NsPerOp(kCount, [&](uint64_t i) { items[i] = pool.New(); });
+		double remote = 0;
+		std::thread consumer([&] {
+			remote = SagaTest::NsPerOp(kCount, [&](uint64_t i) { pool.Delete(items[i]); });
+		});
+		consumer.join();
+		std::printf("%-28s %10.2f\n", "ObjectPool bump alloc", alloc);
+		std::printf("%-28s %10.2f\n", "ObjectPool remote delete", remote);
+	}
+	return 0;
+}
@@ -0,0 +1,45 @@
+#ifndef SG_TESTS_SAGA_TEST_H
+#define SG_TESTS_SAGA_TEST_H
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+//Minimal harness: SG_CHECK records failures, SG_TEST_RESULT is main's return value
+namespace SagaTest {
+
+inline int& Failures() {
+	static int failures = 0;
+	return failures;
+}
+
+inline void Fail(const char* expr, const char* file, int line) {
+	std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+	++Failures();
+}
+
+//Nanoseconds per iteration of fn(i) over `iterations`
+template <typename Fn>
+double NsPerOp(uint64_t iterations, Fn&& fn) {
+	const auto begin = std::chrono::steady_clock::now();
+	for (uint64_t i = 0; i < iterations; ++i) {
+		fn(i);
+	}
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(iterations);
+}
+
+//Keeps the optimizer from dropping a benchmarked result, the address escapes
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+	static const volatile void* sink;
+	sink = &value;
+	std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+} //namespace SagaTest
+
+#define SG_CHECK(expr) ((expr) ? (void)0 : SagaTest::Fail(#expr, __FILE__, __LINE__))
+#define SG_TEST_RESULT() (SagaTest::Failures() == 0 ? 0 : 1)
+
+#endif
@@ -0,0 +1,48 @@
+#include "core/time/coarse_clock.h"
+#include "saga_test.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+//A stamp keeps the time it was taken, not the time of the next Update
+using namespace Core::Time;
+
+namespace {
+
+constexpr int64_t kGapNs = 20'000'000;
+constexpr int64_t kToleranceNs = 5'000'000;
+
+void StampKeepsItsTime() {
+	CoarseClock clock;
+	std::this_thread::sleep_for(std::chrono::milliseconds(50)); //lets the tick rate settle
+	clock.Update();
+
+	const uint64_t first = CoarseClock::Ticks();
+	std::this_thread::sleep_for(std::chrono::nanoseconds(kGapNs));
+	const uint64_t second = CoarseClock::Ticks();
+	clock.Update();
+
+	const int64_t first_ns = clock.ToMonotonicNs(first);
+	const int64_t second_ns = clock.ToMonotonicNs(second);
+	SG_CHECK(second_ns <= clock.MonotonicNs());
+	SG_CHECK(second_ns - first_ns >= kGapNs - kToleranceNs);
+	SG_CHECK(clock.MonotonicNs() - first_ns >= kGapNs - kToleranceNs);
+}
+
+void WallTextFollowsStamp() {
+	CoarseClock clock;
+	const auto now = std::string(clock.WallText());
+	SG_CHECK(clock.WallTextAt(clock.MonotonicNs()) == now);
+	SG_CHECK(clock.WallTextAt(clock.MonotonicNs() - 2'000'000'000) != now);
+	SG_CHECK(clock.WallTextAt(clock.MonotonicNs()) == now);
+}
+
+} //namespace
+
+int main() {
+	StampKeepsItsTime();
+	WallTextFollowsStamp();
+	return SG_TEST_RESULT();
+}
@@ -0,0 +1,84 @@
+#include "core/events/event_bus.h"
+#include "saga_test.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+//Direct publishes and broadcasts of one type share a ring, a drain must see them
+//in publish order, also when a budget splits the drain
+using namespace Core::Event;
+
+namespace {
+
+struct OrderEvent {
+	uint32_t id_;
+};
+
+using OrderDispatcher = EventDispatcher<OrderEvent>;
+using OrderBus = EventBus<DispatcherBinding<ThreadCategory::Main, OrderDispatcher>,
+		DispatcherBinding<ThreadCategory::Renderer, OrderDispatcher>>;
+
+constexpr uint32_t kEvents = 300;
+
+//Every third event is a broadcast, the rest go to Main only
+bool IsBroadcast(uint32_t id) {
+	return id % 3 == 0;
+}
+
+void PublishMixed(OrderBus& bus) {
+	for (uint32_t id = 0; id < kEvents; ++id) {
+		if (IsBroadcast(id)) {
+			SG_CHECK(bus.Broadcast(OrderEvent{ id }) == 2);
+		} else {
+			SG_CHECK(bus.Publish<ThreadCategory::Main>(OrderEvent{ id }));
+		}
+	}
+}
+
+void PublishAndBroadcastKeepOrder() {
+	auto bus = std::make_unique<OrderBus>();
+	std::vector<uint32_t> main_seen;
+	std::vector<uint32_t> renderer_seen;
+	bus->Get<ThreadCategory::Main>().subscribe<OrderEvent>([&main_seen](const OrderEvent& event) { main_seen.push_back(event.id_); });
+	bus->Get<ThreadCategory::Renderer>().subscribe<OrderEvent>([&renderer_seen](const OrderEvent& event) { renderer_seen.push_back(event.id_); });
+
+	PublishMixed(*bus);
+	bus->Get<ThreadCategory::Main>().processAllEvents();
+	bus->Get<ThreadCategory::Renderer>().processAllEvents();
+
+	SG_CHECK(main_seen.size() == kEvents);
+	for (uint32_t i = 0; i < main_seen.size(); ++i) {
+		SG_CHECK(main_seen[i] == i);
+	}
+	SG_CHECK(renderer_seen.size() == (kEvents + 2) / 3);
+	for (uint32_t i = 0; i < renderer_seen.size(); ++i) {
+		SG_CHECK(renderer_seen[i] == i * 3);
+	}
+}
+
+void BudgetedDrainKeepsOrder() {
+	auto bus = std::make_unique<OrderBus>();
+	std::vector<uint32_t> seen;
+	auto& dispatcher = bus->Get<ThreadCategory::Main>();
+	dispatcher.subscribe<OrderEvent>([&seen](const OrderEvent& event) { seen.push_back(event.id_); });
+
+	PublishMixed(*bus);
+	while (dispatcher.processUpTo(7) != 0) {
+	}
+	bus->Get<ThreadCategory::Renderer>().processAllEvents();
+
+	SG_CHECK(seen.size() == kEvents);
+	for (uint32_t i = 0; i < seen.size(); ++i) {
+		SG_CHECK(seen[i] == i);
+	}
+	SG_CHECK(dispatcher.isQueueEmpty());
+}
+
+} //namespace
+
+int main() {
+	PublishAndBroadcastKeepOrder();
+	BudgetedDrainKeepsOrder();
+	return SG_TEST_RESULT();
+}
@@ -0,0 +1,129 @@
+#include "core/memory/arena/frame_arena.h"
+#include "saga_test.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+//Every heap allocation in the process goes through here
+namespace {
+std::atomic<size_t> g_allocations{ 0 };
+std::atomic<bool> g_fail_next{ false };
+
+void* CountedAlloc(size_t bytes, size_t alignment) {
+	if (g_fail_next.exchange(false)) {
+		throw std::bad_alloc();
+	}
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	alignment = alignment < sizeof(void*) ? sizeof(void*) : alignment;
+	bytes = (bytes + alignment - 1) & ~(alignment - 1);
+	if (void* ptr = std::aligned_alloc(alignment, bytes == 0 ? alignment : bytes)) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+} //namespace
+
+void* operator new(size_t bytes) { return CountedAlloc(bytes, alignof(std::max_align_t)); }
+void* operator new[](size_t bytes) { return CountedAlloc(bytes, alignof(std::max_align_t)); }
+void* operator new(size_t bytes, std::align_val_t align) { return CountedAlloc(bytes, size_t(align)); }
+void* operator new[](size_t bytes, std::align_val_t align) { return CountedAlloc(bytes, size_t(align)); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+
+using Core::Memory::FrameArena;
+using Core::Memory::LinearArena;
+
+namespace {
+
+//What a frame does with its scratch: a few pmr containers sized by the frame's work
+void RecordFrame(FrameArena& frames, size_t items) {
+	std::pmr::vector<uint64_t> visible(frames.Resource());
+	std::pmr::vector<float> depths(frames.Resource());
+	for (size_t i = 0; i < items; ++i) {
+		visible.push_back(i);
+		depths.push_back(float(i));
+	}
+	auto* matrices = frames.Allocate<float>(16 * items);
+	matrices[0] = depths.back();
+	SagaTest::DoNotOptimize(matrices);
+}
+
+void SteadyStateFramesDoNotAllocate() {
+	FrameArena frames(2, 64 * 1024);
+	//Warm-up may overflow and grow
+	for (uint32_t frame = 0; frame < 4; ++frame) {
+		frames.BeginFrame(frame);
+		RecordFrame(frames, 1000);
+	}
+	const size_t before = g_allocations.load();
+	for (uint32_t frame = 4; frame < 1004; ++frame) {
+		frames.BeginFrame(frame);
+		RecordFrame(frames, 1000);
+	}
+	SG_CHECK(g_allocations.load() == before);
+}
+
+void OverflowGrowsOnce() {
+	LinearArena arena(1024);
+	SG_CHECK(arena.HeapAllocations() == 1);
+	for (int i = 0; i < 8; ++i) {
+		arena.Allocate(512);
+	}
+	//Six overflow blocks, then Reset folds them into one bigger buffer
+	SG_CHECK(arena.HeapAllocations() == 1 + 6);
+	arena.Reset();
+	SG_CHECK(arena.HeapAllocations() == 1 + 6 + 1);
+	SG_CHECK(arena.Capacity() >= 8 * 512);
+	const size_t before = g_allocations.load();
+	for (int frame = 0; frame < 100; ++frame) {
+		for (int i = 0; i < 8; ++i) {
+			arena.Allocate(512);
+		}
+		arena.Reset();
+	}
+	SG_CHECK(g_allocations.load() == before);
+}
+
+void FailedGrowthKeepsBuffer() {
+	LinearArena arena(1024);
+	arena.Allocate(2048);
+	const size_t capacity = arena.Capacity();
+	g_fail_next = true;
+	arena.Reset();
+	//Growth failed, the old buffer must still be usable at its old size
+	SG_CHECK(arena.Capacity() == capacity);
+	auto* bytes = static_cast<char*>(arena.Allocate(capacity));
+	for (size_t i = 0; i < capacity; ++i) {
+		bytes[i] = char(i);
+	}
+	SG_CHECK(arena.Used() == capacity);
+	arena.Reset();
+}
+
+void AlignmentHonoured() {
+	LinearArena arena(4096);
+	arena.Allocate(1, 1);
+	SG_CHECK(reinterpret_cast<uintptr_t>(arena.Allocate(8, 64)) % 64 == 0);
+	//Overflow path too
+	SG_CHECK(reinterpret_cast<uintptr_t>(arena.Allocate(8192, 256)) % 256 == 0);
+	arena.Reset();
+}
+
+} //namespace
+
+int main() {
+	SteadyStateFramesDoNotAllocate();
+	OverflowGrowsOnce();
+	FailedGrowthKeepsBuffer();
+	AlignmentHonoured();
+	return SG_TEST_RESULT();
+}
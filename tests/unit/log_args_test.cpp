@@ -0,0 +1,60 @@
+#include "core/io/log/log.h"
+#include "saga_test.h"
+
+#include <string>
+
+using namespace Core::Log;
+
+namespace {
+
+template <typename... Stored, typename... Args>
+std::string RoundTrip(size_t slack, std::string_view format, const Args&... args) {
+	std::byte buffer[LogRecord::kArgCapacity]{};
+	Detail::LogArgWriter writer(buffer, slack);
+	(writer.Put(args), ...);
+	std::string out;
+	Detail::FormatLogArgs<Stored...>(out, format, buffer);
+	return out;
+}
+
+void FitsUnchanged() {
+	const std::string text = RoundTrip<std::string_view, int>(64, "{} {}", "hello", 42);
+	SG_CHECK(text == "hello 42");
+}
+
+void TruncationIsMarked() {
+	const std::string message(1000, 'x');
+	const std::string text = RoundTrip<std::string_view>(200, "{}", message);
+	SG_CHECK(text.size() <= 200);
+	//The head survives and the marker says how much is missing
+	const size_t open = text.find("\xE2\x80\xA6[+");
+	SG_CHECK(open != std::string::npos);
+	SG_CHECK(text.find_first_not_of('x') == open);
+	SG_CHECK(text.back() == ']');
+	const size_t cut = std::stoul(text.substr(open + 5));
+	SG_CHECK(open + cut == message.size());
+}
+
+void LaterStringsGetWhatIsLeft() {
+	const std::string first(150, 'a');
+	const std::string second(150, 'b');
+	const std::string text = RoundTrip<std::string_view, std::string_view>(200, "{}|{}", first, second);
+	SG_CHECK(text.starts_with(first + "|"));
+	SG_CHECK(text.find("\xE2\x80\xA6[+") != std::string::npos);
+	SG_CHECK(text.size() <= 200 + 1);
+}
+
+void TinySlackStillBounded() {
+	const std::string text = RoundTrip<std::string_view>(4, "{}", std::string(50, 'z'));
+	SG_CHECK(text.size() <= 4);
+}
+
+} //namespace
+
+int main() {
+	FitsUnchanged();
+	TruncationIsMarked();
+	LaterStringsGetWhatIsLeft();
+	TinySlackStillBounded();
+	return SG_TEST_RESULT();
+}
@@ -0,0 +1,56 @@
+#include "core/io/log/log_binary.h"
+#include "core/io/log/log_sink.h"
+#include "saga_test.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Core::Log;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr LogSite kSite{ "value {}", __FILE__, __LINE__, LogRank::kInfo, LogPolicy::kSimple, LogCategory::kGeneral };
+
+void MissingDirectoryIsReported() {
+	MappedFileSink sink((fs::temp_directory_path() / "saga_no_such_dir" / "log").string());
+	SG_CHECK(!sink.IsOpen());
+	//Writing to a closed sink is a no-op, not a crash
+	sink.Write(LogEntry{ &kSite, 0, {}, "dropped" });
+}
+
+void RotatesAcrossFiles() {
+	const fs::path dir = fs::temp_directory_path() / "saga_mapped_sink_test";
+	fs::remove_all(dir);
+	fs::create_directories(dir);
+	const std::string base = (dir / "log").string();
+	{
+		MappedFileSink sink(base, 64 * 1024, 2);
+		SG_CHECK(sink.IsOpen());
+		const std::string text(100, 'x');
+		for (int i = 0; i < 1000; ++i) {
+			sink.Write(LogEntry{ &kSite, i, {}, text });
+		}
+		SG_CHECK(sink.IsOpen());
+	}
+	//Two files in rotation, each starting with a valid header
+	for (int i = 0; i < 2; ++i) {
+		std::ifstream file(base + "." + std::to_string(i) + ".sglog", std::ios::binary);
+		Binary::FileHeader header{};
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		SG_CHECK(file.good());
+		SG_CHECK(header.magic_ == Binary::kMagic);
+	}
+	fs::remove_all(dir);
+}
+
+} //namespace
+
+int main() {
+	MissingDirectoryIsReported();
+	RotatesAcrossFiles();
+	return SG_TEST_RESULT();
+}
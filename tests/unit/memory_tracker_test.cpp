@@ -0,0 +1,54 @@
+#include "core/memory/tracking/memory_tracker.h"
+#include "saga_test.h"
+
+#include <thread>
+#include <vector>
+
+using namespace Core::Memory;
+
+namespace {
+
+const TagStats& Stats(const MemoryReport& report, MemoryTag tag) {
+	return report.tags[static_cast<size_t>(tag)];
+}
+
+void PeakSurvivesFreeBetweenSnapshots() {
+	const auto before = Stats(MemoryTracker::Snapshot(), MemoryTag::kAsset);
+	{
+		std::vector<char, TrackedAllocator<char, MemoryTag::kAsset>> big(1 << 20);
+		SagaTest::DoNotOptimize(big.data());
+	}
+	//Freed before anyone took a snapshot, the peak must still show it
+	const auto after = Stats(MemoryTracker::Snapshot(), MemoryTag::kAsset);
+	SG_CHECK(after.bytes == before.bytes);
+	SG_CHECK(after.high_water >= before.bytes + (1 << 20));
+	SG_CHECK(after.total_allocations == before.total_allocations + 1);
+}
+
+void CrossThreadFreeBalances() {
+	const auto before = Stats(MemoryTracker::Snapshot(), MemoryTag::kRenderer);
+	auto* data = new std::vector<int, TrackedAllocator<int, MemoryTag::kRenderer>>(1000);
+	std::thread([data] { delete data; }).join();
+	const auto after = Stats(MemoryTracker::Snapshot(), MemoryTag::kRenderer);
+	SG_CHECK(after.bytes == before.bytes);
+	SG_CHECK(after.allocations == before.allocations);
+}
+
+struct alignas(128) Wide {
+	char bytes_[128];
+};
+
+void OverAlignedTypes() {
+	std::vector<Wide, TrackedAllocator<Wide, MemoryTag::kGeneral>> items(3);
+	SG_CHECK(reinterpret_cast<uintptr_t>(items.data()) % 128 == 0);
+}
+
+} //namespace
+
+int main() {
+	static_assert(MemoryTracker::Enabled());
+	PeakSurvivesFreeBetweenSnapshots();
+	CrossThreadFreeBalances();
+	OverAlignedTypes();
+	return SG_TEST_RESULT();
+}
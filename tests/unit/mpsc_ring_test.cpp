@@ -0,0 +1,94 @@
+#include "core/memory/lockfree/MPSC/ring.h"
+#include "saga_test.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using Core::Memory::LockFreeMpscRing;
+
+namespace {
+
+//Producer id in the top bits, per-producer sequence below
+constexpr uint64_t Encode(uint64_t producer, uint64_t seq) { return producer << 40 | seq; }
+
+void SingleThreadFifo() {
+	LockFreeMpscRing<int, 8> ring;
+	for (int i = 0; i < 8; ++i) {
+		SG_CHECK(ring.push(i));
+	}
+	SG_CHECK(!ring.push(8));
+	SG_CHECK(ring.size() == 8);
+
+	int expected = 0;
+	SG_CHECK(ring.consume([&](int value) { SG_CHECK(value == expected++); }, 3) == 3);
+	SG_CHECK(ring.consume([&](int value) { SG_CHECK(value == expected++); }) == 5);
+	SG_CHECK(ring.empty());
+
+	//Wraps around the slot array
+	for (int round = 0; round < 100; ++round) {
+		SG_CHECK(ring.push(round));
+		SG_CHECK(ring.consume([&](int value) { SG_CHECK(value == round); }) == 1);
+	}
+}
+
+void StressProducers(uint32_t producers) {
+	constexpr uint64_t kPerProducer = 200000;
+	auto ring = std::make_unique<LockFreeMpscRing<uint64_t, 1024>>();
+	std::atomic<bool> go{ false };
+	std::vector<std::thread> threads;
+	for (uint32_t p = 0; p < producers; ++p) {
+		threads.emplace_back([&, p] {
+			while (!go.load(std::memory_order_acquire)) {
+				std::this_thread::yield();
+			}
+			for (uint64_t seq = 0; seq < kPerProducer;) {
+				if (ring->push(Encode(p, seq))) {
+					++seq;
+				} else {
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	//Every event arrives exactly once and in order per producer
+	std::vector<uint64_t> next(producers, 0);
+	uint64_t received = 0;
+	bool ordered = true;
+	go.store(true, std::memory_order_release);
+	while (received < kPerProducer * producers) {
+		const size_t taken = ring->consume([&](uint64_t value) {
+			const uint64_t producer = value >> 40;
+			const uint64_t seq = value & ((uint64_t(1) << 40) - 1);
+			ordered &= producer < producers && seq == next[producer];
+			if (producer < producers) {
+				next[producer] = seq + 1;
+			}
+		});
+		received += taken;
+		if (taken == 0) {
+			std::this_thread::yield();
+		}
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	SG_CHECK(ordered);
+	SG_CHECK(ring->empty());
+	for (uint32_t p = 0; p < producers; ++p) {
+		SG_CHECK(next[p] == kPerProducer);
+	}
+}
+
+} //namespace
+
+int main() {
+	SingleThreadFifo();
+	for (uint32_t producers : { 1u, 2u, 4u, 8u, 16u }) {
+		StressProducers(producers);
+	}
+	return SG_TEST_RESULT();
+}
@@ -0,0 +1,163 @@
+#include "core/memory/pool/free_list.h"
+#include "saga_test.h"
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+using Core::Memory::ObjectPool;
+
+namespace {
+
+struct Item {
+	uint64_t value_;
+	explicit Item(uint64_t value) :
+			value_(value) {}
+};
+
+void SingleThreadReuse() {
+	ObjectPool<Item, 64> pool;
+	std::vector<Item*> items;
+	for (uint64_t i = 0; i < 1000; ++i) {
+		items.push_back(pool.New(i));
+	}
+	std::set<Item*> unique(items.begin(), items.end());
+	SG_CHECK(unique.size() == items.size());
+	for (uint64_t i = 0; i < items.size(); ++i) {
+		SG_CHECK(items[i]->value_ == i);
+	}
+	const size_t slabs = pool.SlabCount();
+	SG_CHECK(slabs == (1000 + pool.ObjectsPerSlab() - 1) / pool.ObjectsPerSlab());
+
+	//Freed objects are handed out again before any new slab
+	for (Item* item : items) {
+		pool.Delete(item);
+	}
+	for (uint64_t i = 0; i < 1000; ++i) {
+		SG_CHECK(unique.contains(pool.New(i)));
+	}
+	SG_CHECK(pool.SlabCount() == slabs);
+}
+
+void SlabAlignment() {
+	ObjectPool<Item, 16> pool;
+	for (int i = 0; i < 100; ++i) {
+		Item* item = pool.New(i);
+		const auto slab = reinterpret_cast<uintptr_t>(item) & ~(pool.SlabSize() - 1);
+		SG_CHECK(reinterpret_cast<uintptr_t>(item) - slab >= sizeof(uint32_t));
+		SG_CHECK(reinterpret_cast<uintptr_t>(item) - slab < pool.SlabSize());
+	}
+}
+
+void ReleaseDropsAllSlabs() {
+	ObjectPool<Item, 32> pool;
+	for (size_t i = 0; i < pool.ObjectsPerSlab() * 3; ++i) {
+		pool.New(i);
+	}
+	SG_CHECK(pool.SlabCount() > 1);
+	pool.Release();
+	SG_CHECK(pool.SlabCount() == 0);
+	//Usable again after a release
+	Item* item = pool.New(7);
+	SG_CHECK(item != nullptr && item->value_ == 7);
+	SG_CHECK(pool.SlabCount() == 1);
+}
+
+void CrossThreadFree() {
+	ObjectPool<Item, 128> pool;
+	constexpr int kCount = 20000;
+	std::vector<Item*> items(kCount);
+	std::thread producer([&] {
+		for (int i = 0; i < kCount; ++i) {
+			items[i] = pool.New(uint64_t(i));
+		}
+	});
+	producer.join();
+	const size_t slabs = pool.SlabCount();
+
+	//Frees from other threads land on the owner's remote list
+	std::vector<std::thread> freers;
+	for (int t = 0; t < 4; ++t) {
+		freers.emplace_back([&, t] {
+			for (int i = t; i < kCount; i += 4) {
+				SG_CHECK(items[i]->value_ == uint64_t(i));
+				pool.Delete(items[i]);
+			}
+		});
+	}
+	for (auto& thread : freers) {
+		thread.join();
+	}
+
+	//The owner's slot is recycled by the next thread, which takes the remote list back
+	std::thread consumer([&] {
+		for (int i = 0; i < kCount; ++i) {
+			pool.New(uint64_t(i));
+		}
+	});
+	consumer.join();
+	SG_CHECK(pool.SlabCount() <= slabs * 2);
+}
+
+void ConcurrentNewDelete() {
+	ObjectPool<Item, 256> pool;
+	std::atomic<int> wrong{ 0 };
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 8; ++t) {
+		threads.emplace_back([&, t] {
+			std::vector<Item*> live;
+			for (int round = 0; round < 50; ++round) {
+				for (int i = 0; i < 200; ++i) {
+					live.push_back(pool.New(uint64_t(t) << 32 | uint64_t(i)));
+				}
+				for (int i = 0; i < 200; ++i) {
+					if (live[i]->value_ != (uint64_t(t) << 32 | uint64_t(i))) {
+						wrong.fetch_add(1);
+					}
+					pool.Delete(live[i]);
+				}
+				live.clear();
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	SG_CHECK(wrong.load() == 0);
+}
+
+} //namespace
+
+//Whether or not the hugetlb pool has pages (CI has none), the memory must be
+//usable; a reservation that faults on first touch kills the process with SIGBUS
+void HugePagesWithoutReservedPool() {
+	using Core::Memory::PagePolicy;
+	auto region = Core::Memory::SystemReserve(Core::Memory::kHugePageSize * 2, PagePolicy::kHuge);
+	SG_CHECK(region.ptr != nullptr);
+	SG_CHECK(region.size >= Core::Memory::kHugePageSize * 2);
+	auto* bytes = static_cast<volatile unsigned char*>(region.ptr);
+	for (size_t i = 0; i < region.size; i += 4096) {
+		bytes[i] = static_cast<unsigned char>(i);
+	}
+	Core::Memory::SystemRelease(region);
+
+	ObjectPool<Item, 64> pool(PagePolicy::kHuge);
+	std::vector<Item*> items;
+	for (uint64_t i = 0; i < pool.ObjectsPerSlab() * 4; ++i) {
+		items.push_back(pool.New(i));
+	}
+	for (uint64_t i = 0; i < items.size(); ++i) {
+		SG_CHECK(items[i]->value_ == i);
+	}
+}
+
+int main() {
+	SingleThreadReuse();
+	SlabAlignment();
+	ReleaseDropsAllSlabs();
+	CrossThreadFree();
+	ConcurrentNewDelete();
+	HugePagesWithoutReservedPool();
+	return SG_TEST_RESULT();
+}
@@ -0,0 +1,151 @@
+#include "drivers/vulkan/commands/vk_commandpool.h"
+#include "drivers/vulkan/commands/vk_upload_manager.h"
+#include "drivers/vulkan/extensions/vk_surface.h"
+#include "drivers/vulkan/memory/vk_staging_ring.h"
+#include "drivers/vulkan/memory/vk_vma_allocator.h"
+#include "drivers/vulkan/vk_device.h"
+#include "drivers/vulkan/vk_instance.h"
+#include "saga_test.h"
+
+#include <SDL3/SDL.h>
+#include <coroutine>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+//Runs headless: SDL's offscreen driver gives a VK_EXT_headless_surface window,
+//so a software device (lavapipe) is enough. Skipped when there is no device.
+using namespace Driver::Vulkan;
+using namespace Driver::Vulkan::Memory;
+
+namespace {
+
+constexpr int kSkip = 77;
+constexpr size_t kWords = 1024;
+
+//Fire-and-forget, only the side effect of resuming is observed
+struct Detached {
+	struct promise_type {
+		Detached get_return_object() noexcept { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() noexcept {}
+		void unhandled_exception() noexcept {}
+	};
+};
+
+Detached AwaitUpload(VulkanUploadManager& upload, UploadTicket ticket, bool& resumed) {
+	co_await upload.Await(ticket);
+	resumed = true;
+}
+
+std::vector<uint32_t> Pattern(uint32_t seed) {
+	std::vector<uint32_t> words(kWords);
+	for (size_t i = 0; i < kWords; ++i) {
+		words[i] = seed * 2654435761u + static_cast<uint32_t>(i);
+	}
+	return words;
+}
+
+//Host-readable destination, the copies land where the test can compare them
+VulkanAllocator::Buffer CreateReadback(VulkanAllocator& allocator) {
+	return allocator.CreateBuffer(kWords * sizeof(uint32_t), VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VMA_MEMORY_USAGE_GPU_TO_CPU, VMA_ALLOCATION_CREATE_MAPPED_BIT, "UploadTestReadback");
+}
+
+bool Matches(VulkanAllocator& allocator, const VulkanAllocator::Buffer& buffer, const std::vector<uint32_t>& expected) {
+	allocator.InvalidateMemory(buffer.allocation);
+	return std::memcmp(buffer.GerMappedData(), expected.data(), kWords * sizeof(uint32_t)) == 0;
+}
+
+//With a dedicated transfer family a ticket completes once graphics acquired it
+void HandOff(const VulkanDevice& device, VulkanUploadManager& upload) {
+	if (!upload.IsDedicated()) {
+		return;
+	}
+	VulkanCommandPool pool(device.GetDevice(), device.GetGraphicsFamily());
+	auto command = pool.CreateCommand(device.GetGraphyciQueue());
+	command->BeginRecording(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+	upload.RecordAcquires(*command);
+	command->EndRecording();
+}
+
+void TicketsCompleteInOrder(const VulkanDevice& device, VulkanAllocator& allocator, VulkanUploadManager& upload) {
+	//Twice the batch count, OpenBatch has to recycle batches still in flight
+	constexpr uint32_t kUploads = VulkanUploadManager::kBatchCount * 2;
+	std::vector<VulkanAllocator::Buffer> targets;
+	std::vector<UploadTicket> tickets;
+	for (uint32_t i = 0; i < kUploads; ++i) {
+		targets.push_back(CreateReadback(allocator));
+		tickets.push_back(upload.UploadBufferData(allocator.CreateStagingBuffer(Pattern(i)), targets.back()));
+		SG_CHECK(upload.Flush().value_ == tickets.back().value_);
+		if (i > 0) {
+			SG_CHECK(tickets[i].value_ > tickets[i - 1].value_);
+		}
+	}
+
+	upload.Wait(tickets.back());
+	HandOff(device, upload);
+	for (uint32_t i = 0; i < kUploads; ++i) {
+		SG_CHECK(upload.IsComplete(tickets[i]));
+		SG_CHECK(Matches(allocator, targets[i], Pattern(i)));
+	}
+	for (auto& target : targets) {
+		allocator.DestroyBuffer(target);
+	}
+}
+
+void RingUploadResumesAwaiter(const VulkanDevice& device, VulkanAllocator& allocator, VulkanUploadManager& upload) {
+	VulkanStagingRing ring(allocator, 2);
+	auto target = CreateReadback(allocator);
+	const auto data = Pattern(42);
+
+	const UploadTicket ticket = upload.UploadBufferData(ring.Write(data), target);
+	bool resumed = false;
+	AwaitUpload(upload, ticket, resumed);
+	SG_CHECK(!resumed);
+
+	ring.Flush();
+	upload.Flush();
+	upload.Wait(ticket);
+	HandOff(device, upload);
+	upload.Collect();
+	SG_CHECK(resumed);
+	SG_CHECK(Matches(allocator, target, data));
+	allocator.DestroyBuffer(target);
+}
+
+} //namespace
+
+int main() {
+	SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+	if (!SDL_Init(SDL_INIT_VIDEO) || !SDL_Vulkan_LoadLibrary(nullptr)) {
+		std::printf("skipped: no Vulkan loader (%s)\n", SDL_GetError());
+		return kSkip;
+	}
+	Platform::AppWindow window;
+	if (window.ShouldExit()) {
+		std::printf("skipped: no Vulkan window (%s)\n", SDL_GetError());
+		return kSkip;
+	}
+	VulkanInitializer instance;
+	if (instance.GetPhysicalDevice() == VK_NULL_HANDLE) {
+		std::printf("skipped: no Vulkan device\n");
+		return kSkip;
+	}
+	VulkanSurface surface(window, instance);
+	VulkanDevice device(instance, surface);
+	{
+		const VkInstance vkinstance = instance.GetInstance();
+		const VkDevice vkdevice = device.GetDevice();
+		const VkPhysicalDevice physical = instance.GetPhysicalDevice();
+		VulkanAllocator allocator(vkinstance, vkdevice, physical);
+		VulkanUploadManager upload(device, allocator);
+
+		TicketsCompleteInOrder(device, allocator, upload);
+		RingUploadResumesAwaiter(device, allocator, upload);
+	}
+	vkDeviceWaitIdle(device.GetDevice());
+	return SG_TEST_RESULT();
+}
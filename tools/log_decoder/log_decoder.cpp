@@ -0,0 +1,125 @@
+// Offline decoder for MappedFileSink output (*.sglog)
+// usage: SagaLogDecoder <file.sglog>...
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/io/log/log_binary.h"
+
+namespace {
+
+using namespace Core::Log::Binary;
+
+struct Site {
+	uint8_t rank_ = 0;
+	uint8_t category_ = 0;
+	uint32_t line_ = 0;
+	std::string file_;
+};
+
+const char* RankName(uint8_t rank) {
+	constexpr const char* kNames[] = { "INFO", "WARRING", "ERROR", "VULKAN" };
+	return rank < std::size(kNames) ? kNames[rank] : "?";
+}
+
+const char* CategoryName(uint8_t category) {
+	constexpr const char* kNames[] = { "general", "vulkan", "event", "input", "memory", "context" };
+	return category < std::size(kNames) ? kNames[category] : "?";
+}
+
+template <typename T>
+bool ReadPod(const std::vector<char>& data, size_t offset, T& out) {
+	if (offset + sizeof(T) > data.size()) {
+		return false;
+	}
+	std::memcpy(&out, data.data() + offset, sizeof(T));
+	return true;
+}
+
+bool Decode(const char* path) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		std::fprintf(stderr, "cannot open %s\n", path);
+		return false;
+	}
+	const std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	FileHeader header;
+	if (!ReadPod(data, 0, header) || header.magic_ != kMagic || header.version_ != kVersion) {
+		std::fprintf(stderr, "%s is not a compatible log file\n", path);
+		return false;
+	}
+
+	std::vector<Site> sites;
+	size_t offset = header.header_size_;
+	while (offset < data.size()) {
+		RecordType type;
+		if (!ReadPod(data, offset, type) || type == RecordType::kEnd) {
+			break;
+		}
+		if (type == RecordType::kSite) {
+			SiteRecord record;
+			if (!ReadPod(data, offset, record) ||
+					offset + sizeof(record) + record.file_length_ + record.format_length_ > data.size()) {
+				break;
+			}
+			Site site;
+			site.rank_ = record.rank_;
+			site.category_ = record.category_;
+			site.line_ = record.line_;
+			site.file_.assign(data.data() + offset + sizeof(record), record.file_length_);
+			if (sites.size() <= record.id_) {
+				sites.resize(record.id_ + 1);
+			}
+			sites[record.id_] = std::move(site);
+			offset += sizeof(record) + record.file_length_ + record.format_length_;
+		} else if (type == RecordType::kEntry) {
+			EntryRecord record;
+			if (!ReadPod(data, offset, record) || offset + sizeof(record) + record.length_ > data.size()) {
+				break;
+			}
+			const Site unknown;
+			const Site& site = record.site_ < sites.size() ? sites[record.site_] : unknown;
+			const std::string_view text(data.data() + offset + sizeof(record), record.length_);
+
+			const int64_t wall_ns = header.wall_base_ns_ + (record.timestamp_ns_ - header.monotonic_base_ns_);
+			const std::time_t seconds = static_cast<std::time_t>(wall_ns / 1000000000);
+			std::tm tm_buf;
+#ifdef _WIN32
+			localtime_s(&tm_buf, &seconds);
+#else
+			localtime_r(&seconds, &tm_buf);
+#endif
+			char time_buf[32];
+			std::strftime(time_buf, sizeof(time_buf), "%Y-%m-%d %H:%M:%S", &tm_buf);
+			std::printf("[%s.%03d] %-7s [%s] %s:%u %.*s\n", time_buf, static_cast<int>((wall_ns / 1000000) % 1000),
+					RankName(site.rank_), CategoryName(site.category_), site.file_.c_str(), site.line_,
+					static_cast<int>(text.size()), text.data());
+			offset += sizeof(record) + record.length_;
+		} else {
+			std::fprintf(stderr, "%s: unknown record at %zu, stopping\n", path, offset);
+			break;
+		}
+	}
+	return true;
+}
+
+} //namespace
+
+int main(int argc, char* argv[]) {
+	if (argc < 2) {
+		std::fprintf(stderr, "usage: %s <file.sglog>...\n", argv[0]);
+		return 1;
+	}
+	bool ok = true;
+	for (int i = 1; i < argc; ++i) {
+		ok = Decode(argv[i]) && ok;
+	}
+	return ok ? 0 : 1;
+}